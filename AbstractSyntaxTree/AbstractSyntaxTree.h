@@ -3,12 +3,23 @@
 
 #include "../LanguageDictionary/LanguageDictionary.h"
 #include "../SymbolTable/symbolTable.h"
-#include "../ErrorHandler/ErrorHandler.h"
-#include "AuxillaryTree.h"
+#include "../ErrorHandler/errorHandler.h"
+#include "../BufferedWriter/bufferedWriter.h"
+#include "../WorkerPool/workerPool.h"
+#include "../ProgramImage/programImage.h"
+#include "CompactTree.h"
+#include "ConstantFolder.h"
+#include "TypeChecker.h"
+#include "../Optimizer/optimizer.h"
 
 // Standard Library
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <exception>
 #include <vector>
 #include <string>
+#include <stdexcept>
 #include <iostream>
 
 /** Entended Backus-Naur Form for HLint
@@ -23,8 +34,10 @@
  * Literal := '"' {Character} '"' | Number
  *
  * Identifier := letter, {letter | digit | '_'}, End-Of-Statement
- * Mathematical-Operator := '+' | '-'
- * Mathematical-Expression := Identifier, Mathematical-Operator, Identifier, (Mathematical-Operator, Identifier)*
+ * Mathematical-Operator := '+' | '-' | '*' | '/'
+ * Operand := Identifier | Literal | '(', Mathematical-Expression, ')'
+ * Mathematical-Expression := Operand, {Mathematical-Operator, Operand}
+ *     '*' and '/' bind tighter than '+' and '-'. Operators of the same precedence are grouped from the left
  *
  * Assignment := Identifier, ':=', (Identifier | Literal | Mathematical-Expression), End-Of-Statement
  * Type := 'integer' | 'float'
@@ -33,6 +46,8 @@
  * Condition := (Identifier | Literal), ('<' | '>' | '==' | '!=') , (Identifier | Literal)
  * Statement := Assignment | Declaration | Output
  * One-Way-If-Condition := 'if', '(', Condition, ')', Statement, End-Of-Statement
+ * While-Loop := 'while', '(', Condition, ')', '{', {Statement | Declaration | One-Way-If-Condition | While-Loop}, '}'
+ *     A declaration in the body only lasts until the end of the iteration. The ';' after the '}' can be left out
 **/
 
 
@@ -40,10 +55,11 @@ class AST{
 
 // Constructors and Deconstructor
 private:
-    AST(){
-        _file.open(_filename);
+    AST(){}
+    ~AST(){
+        delete _symbolTrace;
+        delete _treeDump;
     }
-    ~AST(){}
 
 // Implementing Singleton
 public:
@@ -64,942 +80,941 @@ public:
 // Owned
 private:
     using               LanguageToken           = LanguageDictionary::LanguageToken;        // Used to Simplify the Code
+    using               NodeIndex               = CompactTree::NodeIndex;                   // A node of the compact tree
     ErrorHandler*       _errorHandler           = &ErrorHandler::getInstance();             // Used to log errors
     LanguageDictionary* _languageDictionary     = &LanguageDictionary::getInstance();       // Used to get the tokens
     SymbolTable*        _symbolTable            = &SymbolTable::getInstance();             // Used to store the variables
-    int                 _parenthesisCount       = 0;                                       // Used to check if the parenthesis are balanced
 
+    // Binding power of the operators, from the loosest to the tightest. An operator only takes operands that bind tighter than itself
+    static constexpr int NoPower                = 0;                                        // Doesn't continue an expression
+    static constexpr int AssignmentPower        = 10;                                       // := and :. Right associative
+    static constexpr int StreamPower            = 20;                                       // << and >>
+    static constexpr int ComparisonPower        = 30;                                       // < > == !=
+    static constexpr int AdditivePower          = 40;                                       // + -
+    static constexpr int MultiplicativePower    = 50;                                       // * /
+
+    static constexpr std::size_t ValidationBlock = 4096;                                    // Statements a worker of evaluateTree() takes at once
 
 private:
-    AuxillaryTree*                  _root                   = nullptr;                          // The root of the tree
-    std::vector<AuxillaryTree*>     _totalityTree;                                              // The totality tree. Contains all the statement trees from all lines
-    std::vector<AuxillaryTree*>     _smallTrees;                                                // The small trees. Contains the statement trees from a single line
-    AuxillaryTree*                  _latestSmallTree        = nullptr;                          // The latest small tree. Used to push the small tree to the totality tree
-    int                             _currentSmallTreeIndex  = 0;                                // The current small tree index. Used to push the small tree to the totality tree
-    int                             _line                   = 0;                                // The current line. Used for better error handling
-    int                             _column                 = 0;                                // The current column. Used for better error handling
-    bool                            _isConditional          = false;                            // Used to check if the current small tree is a conditional statement
-    std::ofstream                   _file;                                                      // The file to write to
-    std::string                     _filename               = "RES_SYM.txt";                    // The file name
+    /**
+     * While Loop (see openBlock)
+     * - "while (condition) {" parses the condition right away. Every statement ended before the matching '}' is parsed on its own
+     *   and kept in the Block, and the whole while becomes a single statement of the script, on the line of the 'while'.
+     * - The body is a chain of '{' nodes, one per statement: the statement on the left, the rest of the body on the right.
+     *   So the trees are run again on every iteration, nothing is parsed again. Every statement of the body keeps its own line
+     *   for the errors (see CompactTree::getBodyLine).
+     * - A while in a body is a statement of that body. So is a declaration, whose variable is removed at the end of every iteration.
+    **/
+    struct Block{
+        Token                   _while;                                                         // The 'while'. The root of the statement
+        Token                   _brace;                                                         // The '{'. Every node of the chain is spelled by it
+        NodeIndex               _condition      = CompactTree::NullNode;
+        std::vector<NodeIndex>  _body;                                                          // Root of every statement of the body, in order
+        bool                    _isValid        = true;                                         // If every node so far follows its grammar rule
+        bool                    _isWhile        = true;                                         // False if the '{' doesn't follow a while. Dropped at its '}'
+    };
+
+    CompactTree                     _trees;                                                     // The totality tree. Every ended statement, in the compact form
+    std::vector<Token>              _statementTokens;                                           // The tokens of the statement being read. Parsed once its ';' comes
+    std::vector<int>                _operatorColumns;                                           // Column of the node of every token of the statement (see scanTokens)
+    std::size_t                     _cursor                 = 0;                                // Next token of the statement to parse
+    bool                            _isStatementValid       = true;                             // If every node of the statement follows its grammar rule
+    std::vector<std::size_t>        _invalidStatements;                                         // Statements with a node that doesn't. In source order
+    BufferedWriter*                 _symbolTrace            = nullptr;                          // Where every evaluated node is written. Only set if it was asked for
+    bool                            _isSymbolTraceBinary    = false;                            // Write the compact binary form instead of text
+    BufferedWriter*                 _treeDump               = nullptr;                          // Where the trees are written before and after optimizeTree(). Only set if it was asked for
+    std::vector<NodeIndex>          _pendingNodes;                                              // Nodes left to visit by forEachUse()
+    std::vector<Block>              _blocks;                                                    // The whiles whose '}' hasn't come yet. The innermost last
+    TypeChecker                     _statementTypes         {_trees};                           // Type check of the watch mode. Keeps the variable types between two saves
 
 public:
-    // Value can be empty
-    void insert(LanguageToken token, std::string value = "", int line = 0, int column = 0){
-        
-        // Set the current line and column
-        _line = line;
-        _column = column;
-
-        bool isConditional = false;
-        bool isTokenAffectsOrderOfOperation = (token == LanguageToken::OpenParenthesisToken) || (isConditional = isConditionalOperator(value));
-        bool isCloseParenthesis = (token == LanguageToken::CloseParenthesisToken);
-
-        if(isTokenAffectsOrderOfOperation){
-            processParenthesisOrOperator(token, value, isConditional);
-        }else if(isCloseParenthesis){
-            processCloseParenthesis(token, value);
-        }else if(token == LanguageToken::EndOfStatementToken){
-            processEndOfStatement();
-        }else if (_latestSmallTree == nullptr){
-            _latestSmallTree = createTree(token, value);
-        }else{
-            processToken(token, value);
+    // Write every node evaluated by evaluateTree() to the given file
+    void openSymbolTrace(std::string filename, bool isBinary){
+        delete _symbolTrace;
+        _symbolTrace = new BufferedWriter(filename);
+        _isSymbolTraceBinary = isBinary;
+
+        // Binary header: magic and format version
+        if(_isSymbolTraceBinary){
+            _symbolTrace->write("HLSY", 4);
+            _symbolTrace->writeUInt32(1);
+        }
+    }
+
+    // Insert a token pulled from the lexer. The text of the token has to stay valid until its statement is ended
+    void insert(const Token& token){
+        switch(token._kind){
+            case LanguageToken::EndOfStatementToken:
+                parseStatement(token._line);
+                return;
+            case LanguageToken::OpenBraceToken:
+                openBlock(token);
+                return;
+            case LanguageToken::CloseBraceToken:
+                closeBlock(token);
+                return;
+            default:
+                _statementTokens.push_back(token);
+                return;
         }
     }
-private:
-    void processToken(LanguageToken &token, std::string &value){
-        bool isOperatorOrKeyword = isOperator(value) || isKeyword(value);
-        if(isOperatorOrKeyword){
-            _latestSmallTree = processOperator(token, value, _latestSmallTree);
-            if(this->isDoubleOperator(_latestSmallTree->_value)){
-                _smallTrees.push_back(_latestSmallTree);
-                _latestSmallTree = nullptr;
-            }
+
+    // Once every token was inserted. A while that is never closed is reported at the end of the source and dropped
+    void endSource(int line, int column){
+        if(!_blocks.empty()){
+            _errorHandler->addError("Expected '}' at the end of the file ", line, column);
+            _blocks.clear();
         }
-        else{
-            if(this->isDoubleOperator(_latestSmallTree->_value) || this->isKeyword(_latestSmallTree->_value)){
-                _smallTrees.push_back(_latestSmallTree);
-                _latestSmallTree = createTree(token, value);
-            }else if(_smallTrees.size() > 1){
+    }
 
-                if(addToAvailableBranchR(_latestSmallTree, token, value)){
-#ifdef DEBUG
-                    std::cout << "Added to a Branch" << std::endl;
-#endif
-                }else if(exhaustRightBranch(_latestSmallTree, token, value)){
-#ifdef DEBUG
-                    std::cout << "Exhausted Right Branch" << std::endl;
-#endif
-                }
-            }else{
-                if(addToAvailableBranchL(_latestSmallTree, token, value)){
-#ifdef DEBUG
-                    std::cout << "Added to a Branch" << std::endl;
-#endif
-                }else if(exhaustRightBranch(_latestSmallTree, token, value)){
-#ifdef DEBUG
-                    std::cout << "Exhausted Left Branch" << std::endl;
-#endif
-                }
+    // Value can be empty
+    void insert(LanguageToken token, std::string_view value = "", int line = 0, int column = 0, NumericValue number = {0}){
+        Token inserted;
+        inserted._kind = token;
+        inserted._text = value;
+        inserted._line = line;
+        inserted._column = column;
+        inserted._number = number;
+        insert(inserted);
+    }
+
+/**
+ * Parser
+ * - Precedence climbing over the tokens of one statement. Every token is looked at once, so a statement is parsed in linear time.
+ * - A chain of operators of the same power is built in a loop, left to right. Only a '(', an 'if' or a right associative
+ *   operator goes one call deeper.
+ * - A missing operand is left as the null node, e.g. the lhs of '*' in "x := * 2". The syntax analyzer reports the operator.
+ * - The errors are where the small-tree parser put them (see scanTokens), so a broken statement reports the same positions as before.
+ * - Every node is checked against its grammar rule as it's added (see isValidNode), so the tree doesn't have to be walked again.
+**/
+private:
+    void parseStatement(int line){
+        NodeIndex root = parseTokens(0, ';');
+
+        // A statement of the body of a while. Empty ones don't run anything
+        if(!_blocks.empty()){
+            Block& block = _blocks.back();
+            if(root != CompactTree::NullNode){
+                block._body.push_back(root);
+                _trees.addBodyStatement(root, line - block._while._line);
             }
-            
+            block._isValid &= _isStatementValid;
+            return;
         }
+        addStatement(root, line);
     }
-public: 
 
-    void evaluateTree(){
-        for(int i = 0; i < _totalityTree.size(); ++i){
-#ifdef DEBUG
-            std::cout << "\nEvaluate [" << i << "]\n";
-#endif
-            if(evaluateTree(_totalityTree[i])){
-#ifdef DEBUG
-                std::cout << "[/] Statement is good" << std::endl;
-#endif
+    // Parses the tokens of the statement from `first` on. `end` is what should have come instead of the tokens left over
+    NodeIndex parseTokens(std::size_t first, char end){
+        _cursor = first;
+        _isStatementValid = true;
+        scanTokens(first);
+
+        NodeIndex root = parseExpression(NoPower);
+
+        // Something that can't continue the statement. The rest of it is dropped. An extra ')' is already reported by scanTokens()
+        if(_cursor < _statementTokens.size()){
+            const Token& token = _statementTokens[_cursor];
+            if(token._kind != LanguageToken::CloseParenthesisToken){
+                _errorHandler->addError(std::string("Expected '") + end + "' before [" + std::string(token._text) + "] ", token._line, token._column);
+            }
+        }
+        _statementTokens.clear();
+        return root;
+    }
+
+    /**
+     * What the small-tree parser reported for the tokens of the statement from `first` on, in one pass before parsing them.
+     * - The parentheses are counted. A ')' that takes the count below 0 is reported, and so is a count that doesn't end at 0.
+     * - The node of an operator is at the first token of the run it's in, the way the small tree it became the root of was.
+     *   A run is cut after every ':=', '<<' and '>>', and by a comparison or a parenthesis, which keep their own column.
+     *   e.g. the '*' of "x := 1 + 2 *" is at the '1'. An operator that starts a run, like the '*' of "x := * 2", is at itself.
+    **/
+    void scanTokens(std::size_t first){
+        _operatorColumns.resize(_statementTokens.size());
+        int parentheses = 0;
+        int run = -1;
+        for(std::size_t i = first; i < _statementTokens.size(); ++i){
+            const Token& token = _statementTokens[i];
+            switch(token._kind){
+                case LanguageToken::OpenParenthesisToken:
+                    ++parentheses;
+                    _operatorColumns[i] = token._column;
+                    run = -1;
+                    break;
+                case LanguageToken::CloseParenthesisToken:
+                    if(--parentheses < 0){
+                        _errorHandler->addError("Parenthesis count is less than 0");
+                    }
+                    _operatorColumns[i] = token._column;
+                    run = -1;
+                    break;
+                case LanguageToken::LessThanToken:
+                case LanguageToken::GreaterThanToken:
+                case LanguageToken::EqualityToken:
+                case LanguageToken::NotEqualToken:
+                    _operatorColumns[i] = token._column;
+                    run = -1;
+                    break;
+                case LanguageToken::AssignmentToken:
+                case LanguageToken::LeftShiftToken:
+                case LanguageToken::RightShiftToken:
+                    _operatorColumns[i] = run < 0 ? token._column : run;
+                    run = -1;
+                    break;
+                default:
+                    if(run < 0){
+                        run = token._column;
+                    }
+                    _operatorColumns[i] = run;
+                    break;
             }
         }
-        _file.close();
+        if(parentheses != 0){
+            _errorHandler->addError("Parenthesis count is not 0");
+        }
     }
 
-// Others
-public:
-
-    
-    void print(){
-        for(int i = 0; i < _totalityTree.size(); ++i){
-            std::cout << "\n#################### Totality [" << i << "] ####################\n";
-            printBT(_totalityTree[i]);
-            std::cout << "#################### Summary [" << i << "] ####################\n";
-            std::cout << summarizeTree(_totalityTree[i]) << '\n';
-            std::cout << "#################### Summarized [" << i << "] ####################\n";
+    void addStatement(NodeIndex root, int line){
+        if(!_isStatementValid){
+            _invalidStatements.push_back(_trees.getStatementCount());
         }
-        std::cout << "TESTING" << std::endl;
+        _trees.addStatement(root, line);
     }
 
-    std::vector<AuxillaryTree*> getTrees(){
-        return _totalityTree;
+    void openBlock(const Token& brace){
+        Block block;
+        block._brace = brace;
+        block._isWhile = !_statementTokens.empty() && _statementTokens.front()._kind == LanguageToken::WhileToken;
+        if(block._isWhile){
+            block._while = _statementTokens.front();
+            block._condition = parseTokens(1, '{');
+            block._isValid = _isStatementValid;
+        }else{
+            reportMisplacedBlock(brace);
+            _statementTokens.clear();
+        }
+        _blocks.push_back(std::move(block));
+    }
+
+    // A '{' that doesn't start the body of a while. Its body is still read up to the '}', and dropped
+    void reportMisplacedBlock(const Token& brace){
+        auto loop = std::find_if(_statementTokens.begin(), _statementTokens.end(), [](const Token& token){
+            return token._kind == LanguageToken::WhileToken;
+        });
+        if(loop == _statementTokens.end()){
+            _errorHandler->addError("Expected a while before [{] ", brace._line, brace._column);
+        }else if(_statementTokens.front()._kind == LanguageToken::IfToken){
+            // e.g. "if (x == 0) while (x < 3) {". Put the if in the body, or the while in an if of its own
+            _errorHandler->addError("A while can't be the statement of an if ", loop->_line, loop->_column);
+        }else{
+            _errorHandler->addError("Expected ';' before [while] ", loop->_line, loop->_column);
+        }
     }
 
-// Auxillary methods
-private:
-    AuxillaryTree* findValidTree(AuxillaryTree* &tree){
-        if (tree == nullptr){
-            return nullptr;
-        }
-        // Traverse until we find a valid tree
-        AuxillaryTree* rhs = nullptr;
-        if(!isLiteralOrIdentifier(tree->_right)){
-            rhs = findValidTree(tree->_right);
-            if(rhs != nullptr){
-                return rhs;
-            }
+    void closeBlock(const Token& brace){
+        if(_blocks.empty()){
+            _errorHandler->addError("Unexpected [}] ", brace._line, brace._column);
+            return;
         }
 
-        AuxillaryTree* lhs = nullptr;
-        if(!isLiteralOrIdentifier(tree->_left)){
-            lhs = findValidTree(tree->_left);
-            if(lhs != nullptr){
-                return lhs;
-            }
+        // The last statement of the body has no ';'. It's dropped
+        if(!_statementTokens.empty()){
+            _errorHandler->addError("Expected ';' before [}] ", brace._line, brace._column);
+            _statementTokens.clear();
+        }
+        Block block = std::move(_blocks.back());
+        _blocks.pop_back();
+        if(!block._isWhile){
+            return;
         }
 
-        if(tree->_left == nullptr || tree->_right == nullptr){
-                return tree;
+        // From the last statement to the first, children come before their parent
+        _isStatementValid = block._isValid;
+        NodeIndex body = CompactTree::NullNode;
+        for(std::size_t i = block._body.size(); i-- > 0;){
+            body = addNode(block._brace, block._body[i], body);
+        }
+        NodeIndex loop = addNode(block._while, block._condition, body);
+
+        if(_blocks.empty()){
+            addStatement(loop, block._while._line);
+            return;
         }
-        return nullptr;
+        _blocks.back()._body.push_back(loop);
+        _blocks.back()._isValid &= _isStatementValid;
+        _trees.addBodyStatement(loop, block._while._line - _blocks.back()._while._line);
     }
 
+    // Parses operators until one binds as loose as `minimumPower` or looser
+    NodeIndex parseExpression(int minimumPower){
+        NodeIndex lhs = parseOperand();
+        while(_cursor < _statementTokens.size()){
+            const Token& token = _statementTokens[_cursor];
+            int power = bindingPower(token._kind);
+            if(power <= minimumPower){
+                break;
+            }
+            ++_cursor;
+            lhs = parseOperator(token, lhs, power);
+        }
+        return lhs;
+    }
 
-// Processes
-private:
-    AuxillaryTree* processOperator(LanguageToken token, std::string value, AuxillaryTree* tree){
-        
-        // Rules for opeartors and keywords
-        bool tokenIsOperatorSize = tree->_value.length() == 1;
-        bool tokenIsOperator = isOperator(tree->_value);
-        bool notAKeyword = !isKeyword(tree->_value);
-        bool notAnOperator = !tokenIsOperatorSize && !tokenIsOperator;
-        bool notAConditional = !isConditionalOperator(tree->_value);
-        bool isDoubleOperator = this->isDoubleOperator(tree->_value);
-
-        // If the token on the latest small node is not an operator or a keyword
-        // notAnOperator && notAKeyword && notAConditional
-        if((notAnOperator && notAConditional) || isDoubleOperator){
-
-            // Then we need to replace the latest small tree with the new tree as its parent 
-            AuxillaryTree* newTree = tree;
-            tree = new  AuxillaryTree(token, value, tree->_line, tree->_column);
-            tree->_left = newTree;
-        }else{
-            // Otherwise, check what kind of operation we are dealing with
-            bool isTokenMultiplicationOrDivision = isMultiplicationOrDivision(token);
-            bool isTreeMultiplicationOrDivision = isMultiplicationOrDivision(tree->_token);
-            if(isTokenMultiplicationOrDivision && !isTreeMultiplicationOrDivision){
-                
-                // Go the left most side of the tree
-                AuxillaryTree* tempTreeParent = tree;
-                AuxillaryTree* tempTree = tree->_right;
-                if(tempTree == nullptr){
-                    // Otherwise, we need make the new created tree the parent of the latest small tree
-                    return replaceParentToLeftOf(tree, token, value);
-                }
-                while(tempTree->_right != nullptr){
-                    if(tempTree->_value == "*" || tempTree->_value == "/"){
-                        break;
+    NodeIndex parseOperand(){
+        if(_cursor >= _statementTokens.size()){
+            return CompactTree::NullNode;
+        }
+        const Token& token = _statementTokens[_cursor];
+        switch(token._kind){
+            case LanguageToken::OpenParenthesisToken:
+                {
+                    ++_cursor;
+                    NodeIndex inner = parseExpression(NoPower);
+                    if(_cursor < _statementTokens.size() && _statementTokens[_cursor]._kind == LanguageToken::CloseParenthesisToken){
+                        ++_cursor;
                     }
-                    tempTree = tempTree->_left;
+                    return inner;
                 }
-                return replaceParentToLeftOf(tempTreeParent, token, value);
-            }else{
-                return replaceParentToLeftOf(tree, token, value);
-            }
+
+            // The condition stops before the statement it guards, e.g. "if (x < 5) output << x". A while is parsed by openBlock()
+            case LanguageToken::IfToken:
+                {
+                    ++_cursor;
+                    NodeIndex condition = parseExpression(StreamPower);
+                    NodeIndex statement = parseExpression(NoPower);
+                    return addNode(token, condition, statement);
+                }
+
+            // Not an operand. Left for the caller
+            case LanguageToken::CloseParenthesisToken:
+                return CompactTree::NullNode;
+            default:
+                break;
+        }
+
+        // An operator where an operand should be. It becomes the parent of the null node
+        if(bindingPower(token._kind) != NoPower){
+            return CompactTree::NullNode;
         }
-        return tree;
+        ++_cursor;
+        return addNode(token, CompactTree::NullNode, CompactTree::NullNode);
     }
 
-    void processEndOfStatement(){
+    // `token` was just taken, so it's right before the cursor
+    NodeIndex parseOperator(const Token& token, NodeIndex lhs, int power){
+        int column = _operatorColumns[_cursor - 1];
 
-        // Check if the parenthesis count is 0
-        if(_parenthesisCount != 0){
-            _errorHandler->addError("Parenthesis count is not 0");
-            //throw std::runtime_error("Parenthesis count is not 0");
+        // Declaration. The type is the root, with the ':' and the identifier under it
+        if(token._kind == LanguageToken::ColonToken && _cursor < _statementTokens.size() && isType(_statementTokens[_cursor]._kind)){
+            const Token& type = _statementTokens[_cursor++];
+            NodeIndex colon = addNode(token, lhs, CompactTree::NullNode, column);
+            return addNode(type, colon, CompactTree::NullNode, column);
         }
 
-        // While there's still something to merge from the small trees
-        while(!_smallTrees.empty()){
+        // Right associative operators take the operators of their own power on their rhs
+        bool isRightAssociative = token._kind == LanguageToken::AssignmentToken || token._kind == LanguageToken::ColonToken;
+        NodeIndex rhs = parseExpression(isRightAssociative ? power - 1 : power);
+        return addNode(token, lhs, rhs, column);
+    }
 
-            // Create a temporary storage from the latest small tree
-            AuxillaryTree* tempTree = _smallTrees.back();
+    NodeIndex addNode(const Token& token, NodeIndex lhs, NodeIndex rhs){
+        return addNode(token, lhs, rhs, token._column);
+    }
 
-            // If the latest smallest tress is null.
-            // More common that you think base on the current implementation
-            if(_latestSmallTree == nullptr){
-                // Set the latest small tree to the temp tree
-                _latestSmallTree = tempTree;
-                // Pop the small tree
-                _smallTrees.pop_back();
-                // And Continue
-                continue;
-            }
-            
-            if(this->isMultiplicationOrDivision(tempTree->_token)){
-            //if(tempTree->_token == LanguageToken::MultiplicationToken){
-                // This tree will be  the child of the latest tree
-
-                // If the parent node is again a multiplication, then it's safe to assume that the latest small tree should be a root node
-                if(this->isMultiplicationOrDivision(_latestSmallTree->_token)){
-                    AuxillaryTree* rhsRoot = _latestSmallTree->_right;
-                    _latestSmallTree->_right = tempTree;
-                    if(addToAvailableBranchL(_latestSmallTree, tempTree)){
-#ifdef DEBUG
-                        std::cout << "Added to a Branch" << std::endl;
-#endif
-                    }else if(addToAvailableBranchL(tempTree, rhsRoot)){
-#ifdef DEBUG
-                        std::cout << "Added to a Branch" << std::endl;
-#endif
-                    }else{
-                        if(rhsRoot != nullptr){
-                            throw std::runtime_error("This Case in not yet Handled by the Language");
-                        }
-                    }
+    NodeIndex addNode(const Token& token, NodeIndex lhs, NodeIndex rhs, int column){
+        NodeIndex node = _trees.addNode(token._kind, lhs, rhs, token._text, token._number, column);
+        if(!isValidNode(node)){
+            _isStatementValid = false;
+        }
+        return node;
+    }
 
- 
-                }else{
-                    AuxillaryTree* lhsRoot = _latestSmallTree->_left;
-                    _latestSmallTree->_left = tempTree;
-                    
-                    if(addToAvailableBranchL(_latestSmallTree, tempTree)){
-#ifdef DEBUG
-                        std::cout << "Added to a Branch" << std::endl;
-#endif
-                    }else if(addToAvailableBranchL(tempTree, lhsRoot)){
-#ifdef DEBUG
-                        std::cout << "Added to a Branch" << std::endl;
-#endif
-                    }else{
-                        if(lhsRoot != nullptr){
-                            throw std::runtime_error("This Case in not yet Handled by the Language");
-                        }
-                    }
-                }
-               _smallTrees.pop_back();
-                continue;
-            }
-                
-            if(addToAvailableBranchR(tempTree, _latestSmallTree)){
-#ifdef DEBUG
-                std::cout << "Added to a Branch" << std::endl;
-#endif
-            }else{
-                // If lhs is not null, then we need to do some processing to maintain the order of operations
-                // This bool is used to check if the temp tree has been changed.
-                // If it's not, then the algorithm found a valid rhs for the temp tree
-                bool newTempTreeChanged = false;
-
-                // Create a new temp tree that will be used to traverse the tree
-                AuxillaryTree *newTempTree = tempTree;
-
-                // Traverse the tree until the rhs is null
-                while(newTempTree->_right != nullptr){
-                    newTempTree = newTempTree->_right;
-                }
-                
-                // If rhs after traversal is a literal or identifier, then we need to do additional processing.
-                // We need to check for other valid tree from the latest small tree and use it as the rhs
-                // This still maintain the order of operation as this case will only happen if
-                // there are parenthesis, where the first statement to be processed is on the far right
-                // This type of situation make it so that that most of the small trees to be complete, which is why
-                // we need to traverse the main tree to find a valid tree.
-                // This can be improved by better implementation of order of operation in the future
-                if(this->isLiteralOrIdentifier(newTempTree)){
-
-                    // Find a valid tree from the latest small tree
-                    if((newTempTree = findValidTree(_latestSmallTree)) == nullptr){
-                        _errorHandler->addError("Invalid tree found");
-                    }
+    static constexpr int bindingPower(LanguageToken token){
+        switch(token){
+            case LanguageToken::AssignmentToken:
+            case LanguageToken::ColonToken:
+                return AssignmentPower;
+            case LanguageToken::LeftShiftToken:
+            case LanguageToken::RightShiftToken:
+                return StreamPower;
+            case LanguageToken::LessThanToken:
+            case LanguageToken::GreaterThanToken:
+            case LanguageToken::EqualityToken:
+            case LanguageToken::NotEqualToken:
+                return ComparisonPower;
+            case LanguageToken::AdditionToken:
+            case LanguageToken::SubtractionToken:
+                return AdditivePower;
+            case LanguageToken::MultiplicationToken:
+            case LanguageToken::DivisionToken:
+                return MultiplicativePower;
+            default:
+                return NoPower;
+        }
+    }
 
-                    // Set the new temp tree changed to true
-                    newTempTreeChanged = true;
-                }
+    static constexpr bool isType(LanguageToken token){
+        return token == LanguageToken::TypeIntegerToken || token == LanguageToken::TypeDoubleToken || token == LanguageToken::TypeStringToken;
+    }
 
-                // If it's changed, then we need to set the rhs of the new temp tree to the temp tree
-                if(newTempTreeChanged){
-                    if(addToAvailableBranchR(newTempTree, tempTree)){
-#ifdef DEBUG
-                        std::cout << "Added to a Branch" << std::endl;
-#endif
-                    }
-                    tempTree = _latestSmallTree;
-                }
+// Syntax Analyzer
+public: 
 
-                // Otherwise we just need to set the rhs of the temp tree to the latest small tree
-                else{
-                    if(addToAvailableBranchR(tempTree, _latestSmallTree)){
+    /**
+     * Reports the nodes the parser found broken. Only the statements that have one are walked, unless every node has to be traced.
+     * - The statements are walked in blocks on `threads` workers (0 is one per core). Every block keeps its own errors and trace,
+     *   which are logged in statement order, so the result is the same as walking them one after another.
+    **/
+    void evaluateTree(unsigned threads = 1){
+        bool isTracing = _symbolTrace != nullptr;
+        std::size_t count = isTracing ? _trees.getStatementCount() : _invalidStatements.size();
+
+        WorkerPool pool(threads);
+        pool.run<Validation>((count + ValidationBlock - 1) / ValidationBlock,
+            [this, isTracing, count](std::size_t block, Validation& validation){
+                std::size_t end = std::min(count, (block + 1) * ValidationBlock);
+                try{
+                    for(std::size_t k = block * ValidationBlock; k < end; ++k){
+                        std::size_t i = isTracing ? k : _invalidStatements[k];
 #ifdef DEBUG
-                        std::cout << "Added to a Branch" << std::endl;
+                        std::cout << "\nEvaluate [" << i << "]\n";
 #endif
+                        evaluateTree(_trees.getRoot(i), _trees.getLine(i), validation);
                     }
-
+                }catch(...){
+                    validation._failure = std::current_exception();
                 }
-           }
+            },
+            [this](Validation& validation){
+                reportValidation(validation);
+            });
 
-            // Update the latest small tree and pop the small tree
-            _latestSmallTree = tempTree;
-            _smallTrees.pop_back();
+        if(isTracing){
+            _symbolTrace->close();
         }
+    }
 
-        // Update the currenet root and push the latest small tree to the totality tree
-        _root = _latestSmallTree;
-        _totalityTree.push_back(_latestSmallTree);
-        _latestSmallTree = nullptr;
-        return;
+/**
+ * Resolution
+ * - Every identifier already has a slot (see CompactTree::getSlot). This pass finds the variables that are used before they are declared.
+ * - Statements run in order, so the declarations made before a statement are known when it's checked.
+ * - Only what runs for sure is checked. The statement of an 'if' and the body of a 'while' may never run, so they are left to the interpreter.
+ *   A declaration under an 'if' is removed right after it runs, so it doesn't declare anything either.
+ * - A variable is reported once, at its first use.
+**/
+public:
+    void resolveVariables(){
+        std::vector<VariableState> states(_trees.getSlotCount(), VariableState::Undeclared);
+        for(std::size_t i = 0; i < _trees.getStatementCount(); ++i){
+            NodeIndex tree = _trees.getRoot(i);
+            int line = _trees.getLine(i);
+            uint32_t declared = declaredSlot(tree);
+            if(declared != CompactTree::NoSlot){
+                states[declared] = VariableState::Declared;
+            }
+            forEachUse(tree, [&](NodeIndex identifier){
+                VariableState& state = states[_trees.getSlot(identifier)];
+                if(state == VariableState::Undeclared){
+                    reportUndeclared(identifier, line);
+                    state = VariableState::Reported;
+                }
+            });
+        }
     }
 
-    void processCloseParenthesis(LanguageToken &token, std::string &value){
+    // Types every node and reports the type errors. See TypeChecker
+    void checkTypes(){
+        TypeChecker checker(_trees);
+        checker.run(1, _invalidStatements);
+    }
 
-        // If the parenthesis count is less than 0, then there is an error
-        if(--_parenthesisCount < 0){
-            _errorHandler->addError("Parenthesis count is less than 0");
+    // The variable a declaration declares. NoSlot for any other statement, or a declaration without a name
+    uint32_t declaredSlot(NodeIndex tree) const{
+        if(!isType(_trees.getToken(tree))){
+            return CompactTree::NoSlot;
         }
-        
-        // If the small tree is empty, then there's no point in continuing
-        if(_smallTrees.empty()){
+        NodeIndex identifier = _trees.getLeft(_trees.getLeft(tree));
+        return _trees.getToken(identifier) == LanguageToken::IdentifierToken ? _trees.getSlot(identifier) : CompactTree::NoSlot;
+    }
+
+    /**
+     * Calls `use` with every identifier of the statement that the resolution checks, in order.
+     * - Nothing of a declaration, the condition of an 'if' or a 'while', the whole tree of anything else.
+     * - Walked with a stack, expressions can be deeper than the call stack. So `use` can't start another walk.
+    **/
+    template<typename Use>
+    void forEachUse(NodeIndex tree, Use use){
+        LanguageToken token = _trees.getToken(tree);
+        if(isType(token)){
             return;
         }
-        
-        // Get the latest smallest tree from the small trees
-        AuxillaryTree* lastSmallTree = _smallTrees.back();
+        _pendingNodes.clear();
+        _pendingNodes.push_back(token == LanguageToken::IfToken || token == LanguageToken::WhileToken ? _trees.getLeft(tree) : tree);
+        while(!_pendingNodes.empty()){
+            NodeIndex node = _pendingNodes.back();
+            _pendingNodes.pop_back();
+            if(node == CompactTree::NullNode){
+                continue;
+            }
+            if(_trees.getToken(node) == LanguageToken::IdentifierToken){
+                use(node);
+            }
+            _pendingNodes.push_back(_trees.getRight(node));
+            _pendingNodes.push_back(_trees.getLeft(node));
+        }
+    }
 
-        // Check if it's a conditional operator or a double operator
-        bool isConditional = this->isConditionalOperator(lastSmallTree->_value);
-        bool isDoubleOperator = this->isDoubleOperator(lastSmallTree->_value);
+    void reportUndeclared(NodeIndex identifier, int line){
+        _errorHandler->addError("Variable [" + std::string(_trees.getValue(identifier)) + "] is not declared ", line, _trees.getColumn(identifier));
+    }
 
-        // If it's a double operator, then push the small tree to the totality tree to maintain precedence
-        if(isDoubleOperator && !isConditional){
-            _smallTrees.push_back(_latestSmallTree);
-            _latestSmallTree = nullptr;
-            return;
-        }
+private:
+    enum class VariableState : uint8_t{
+        Undeclared,                                                                             // Not declared yet
+        Declared,                                                                               // Declared by a statement before
+        Reported                                                                                // Used before it was declared. Already reported
+    };
 
-        // if there are still parenthesis left, there's a possibility that a statement has a higher precedence that the current small tree. So return, and let the next statement handle it
-        if(_parenthesisCount > 0){
-            return;
-        }
+// Statement at a time. Used by the watch mode to rebuild only the statements that changed
+public:
 
-        // Otherwise, pop the latest small tree from the small tree and process it
-        _smallTrees.pop_back();
+    // Forget whatever was left from the previous statement so the next one is parsed on its own
+    void resetStatement(){
+        _statementTokens.clear();
+        _blocks.clear();
+        _cursor = 0;
+        _isStatementValid = true;
+    }
 
-        // If both lhs and rhs are not null
-        if(lastSmallTree->_left != nullptr && lastSmallTree->_right != nullptr){
-            // Then there's probably a nullptr value in the _latestSmallTree
-            // Find it, and replace it with the last small tree
-            
-            // This happens because of the way the tree is built.
-            // Sometimes, left and right are populated if it's enclosed by parenthesis such as the mathematical expression: (a + b) + c
-            // (a + b) will produce a complete small tree, which wouldn't have any nullptr values
-            // In this case, we are sure that the _latestSmallTree has a nullptr value
+    // Hands over the tree of the statement that was just ended. Its nodes stay in the compact tree until release()
+    NodeIndex takeTree(){
+        if(!_invalidStatements.empty() && _invalidStatements.back() + 1 == _trees.getStatementCount()){
+            _invalidStatements.pop_back();
+        }
+        return _trees.popStatement();
+    }
 
-            if(addToAvailableBranchL(_latestSmallTree, lastSmallTree)){
-#ifdef DEBUG
-                std::cout << "Added to a Branch" << std::endl;
-#endif
-            }else{
-                throw std::runtime_error("This Case in not yet Handled by the Language");
-            }
+    // Validates a single statement tree. Errors are reported on the given line
+    bool evaluateStatement(NodeIndex tree, int line = 0){
+        Validation validation;
+        bool isCorrect = false;
+        try{
+            isCorrect = evaluateTree(tree, line, validation);
+        }catch(...){
+            validation._failure = std::current_exception();
+        }
+        reportValidation(validation);
+        return isCorrect;
+    }
 
-            // Push the updated latest small tree in the small trees
-            _smallTrees.push_back(_latestSmallTree);
+    /**
+     * Hands the trees of the statements back, each on its line, so that a pass over the whole script (checkTypes(), typeStatements())
+     * can run on them. `invalid` are the ones evaluateStatement() found broken, in order. Undone by detachStatements().
+    **/
+    void attachStatements(const std::vector<CompactTree::Statement>& statements, std::vector<std::size_t> invalid){
+        for(const CompactTree::Statement& statement : statements){
+            _trees.addStatement(statement._root, (int)statement._line);
+        }
+        _invalidStatements = std::move(invalid);
+    }
 
-            // Set the latest small tree to null to accept new statements
-            _latestSmallTree = nullptr;
-            
-            return;
+    // The trees stay in the compact tree, like after takeTree()
+    void detachStatements(){
+        while(_trees.getStatementCount() > 0){
+            _trees.popStatement();
         }
+        _invalidStatements.clear();
+    }
 
-        // If there's only one child that is not null
-        else{
-            _smallTrees.push_back(lastSmallTree);
-            lastSmallTree = _latestSmallTree;
-        }
-
-        // If it's a conditional statement, Additional processing is required
-        if(_isConditional){
-            bool foundAConditional = false;
-            int defaultSize = _smallTrees.size();
-            for(int i = 0; i < defaultSize; ++i){
-                auto treeValue = _smallTrees.back();
-                if(this->isConditional(treeValue)){
-                    foundAConditional = true;
-                    treeValue->_right = _latestSmallTree;
-                    _latestSmallTree = treeValue;
-                    _smallTrees.pop_back();
-                    continue;
-                }
-                // Expects that the parenthesis was already merge at this point so othere's only one tree left before the if-token
-                if(foundAConditional){
-                    _latestSmallTree->_left = treeValue;
-                    _smallTrees.pop_back();
-                    break;
+    // If the statement declares a variable, even in a while body. Those decide the type of the variable (see TypeChecker)
+    bool hasDeclaration(NodeIndex tree) const{
+        if(_trees.getToken(tree) == LanguageToken::WhileToken){
+            for(NodeIndex block = _trees.getRight(tree); block != CompactTree::NullNode; block = _trees.getRight(block)){
+                if(hasDeclaration(_trees.getLeft(block))){
+                    return true;
                 }
-                AuxillaryTree* backTree = _smallTrees.back();
-                if(addToAvailableBranchL(backTree, _latestSmallTree)){
-#ifdef DEBUG
-                    std::cout << "Added to a Branch" << std::endl;
-#endif
-                }else{
-                    throw std::runtime_error("This Case in not yet Handled by the Language");
-                }
-                _latestSmallTree = backTree;
-                _smallTrees.pop_back();
             }
-            // Mark the small tree as not conditional. This is because we've already processed it
-            _isConditional = false;
-            
-            // Now to process the if-token, we need to pop the small tree again
-            AuxillaryTree* newLastSmallTree = _smallTrees.back();
-
-            // Check what is available, and append the if-token to it.
+            return false;
+        }
+        return isType(_trees.getToken(tree));
+    }
 
-            if(addToAvailableBranchL(newLastSmallTree, _latestSmallTree)){
-#ifdef DEBUG
-                std::cout << "Added to a Branch" << std::endl;
-#endif
-            }else if(exhaustRightBranch(newLastSmallTree, _latestSmallTree)){
-#ifdef DEBUG
-                std::cout << "Exhausted the Right Branch" << std::endl;
-#endif
-            }else{
-                throw std::runtime_error("This Case in not yet Handled by the Language");
-            }
-            // Update then pop the small tree
-            lastSmallTree = newLastSmallTree;
-            _smallTrees.pop_back();
+    /**
+     * Types the nodes from `first` on, for the watch mode. The nodes before keep their type.
+     * - With `isFindingTypes` the variable types are taken from the attached statements first. They are kept for the next call,
+     *   so as long as no declaration changed (see hasDeclaration), only the trees of a save have to be typed.
+     * - The errors are reported tree by tree, with reportTypes().
+    **/
+    void typeStatements(NodeIndex first, bool isFindingTypes){
+        if(isFindingTypes){
+            _statementTypes.findSlotTypes();
         }
+        _statementTypes.typeNodes(first);
+    }
 
-        // Update the latest small tree base on the processes tree and push it back to the small tree to maintain precedence
-        _latestSmallTree = lastSmallTree;
-        _smallTrees.push_back(_latestSmallTree);
-        _latestSmallTree = nullptr;
-        return;
+    // If a tree typed by typeStatements() has a type error
+    bool hasTypeError(NodeIndex tree) const{
+        return _trees.getType(tree) == CompactTree::ValueType::Invalid;
+    }
+
+    // Reports the type errors of a tree typed by typeStatements(), on the given line
+    void reportTypes(NodeIndex tree, int line){
+        _statementTypes.reportTree(tree, line);
+    }
 
+    // Number of nodes in a tree. Used to know how much of the compact tree a statement holds
+    std::size_t countNodes(NodeIndex tree) const{
+        return _trees.countNodes(tree);
     }
 
+    // Frees every tree at once. Every tree given out before is invalid after this
+    void release(){
+        resetStatement();
+        _trees.clear();
+        std::vector<std::size_t>().swap(_invalidStatements);
+    }
+
+// Optimizer
+public:
 
-    void processParenthesisOrOperator(LanguageToken &token, std::string &value, bool &isConditional){
-        // If it's not a conditional statement, it's a parenthesis
-        if(!isConditional){
-            ++_parenthesisCount;
+    // Write every statement tree before and after optimizeTree() to the given file
+    void openTreeDump(std::string filename){
+        delete _treeDump;
+        _treeDump = new BufferedWriter(filename);
+    }
+
+    // Simplifies the validated trees before they are run. See ConstantFolder, and Optimizer for the whole script pass
+    void optimizeTree(bool isWholeScript = false){
+        if(_treeDump != nullptr){
+            dumpTrees("Before");
         }
-        
-        // If the latest small tree is null and it's a conditional conditional, create a new small tree
-        if(_latestSmallTree == nullptr && isConditional){
-            // This is done so that the conditional statement wouldn't merge without the next part of the condition is read
-            _smallTrees.push_back(createTree(token, value));
-            return;
+        NodeIndex first = (NodeIndex)_trees.getNodeCount() + 1;
+        ConstantFolder folder(_trees);
+        folder.run();
+
+        std::string report;
+        if(isWholeScript){
+            Optimizer optimizer(_trees);
+            optimizer.run();
+            report = "[/] Optimizer removed " + std::to_string(optimizer.getRemovedStatementCount()) + " statement(s) and "
+                + std::to_string(optimizer.getRemovedOperationCount()) + " operation(s). Propagated constants into " + std::to_string(optimizer.getPropagatedCount())
+                + " expression(s), reused " + std::to_string(optimizer.getReusedCount()) + " value(s), decided " + std::to_string(optimizer.getDecidedCount())
+                + " condition(s)\n";
+            std::cerr << report;
         }
-            
-        // If the latest small tree is null and it's not a conditional statement, return
-        else if(_latestSmallTree == nullptr){
-            // This is done because it wouldn't really do anything in the following code. Done for optimization
-            return; 
+
+        // The nodes the passes added
+        TypeChecker checker(_trees);
+        checker.run(first);
+
+        if(_treeDump != nullptr){
+            dumpTrees("After");
+            _treeDump->write("Folded " + std::to_string(folder.getFoldedCount()) + " operation(s), removed " + std::to_string(folder.getIdentityCount())
+                + " identity(s), stripped " + std::to_string(folder.getStringCount()) + " string(s)\n");
+            _treeDump->write(report);
+            _treeDump->close();
         }
-        
-        // Create a new small tree from the latest small tree
-        // This is done so that the current latest small tree wouldn't be affected by the next read. Thereby maitaining its precedence
-        _smallTrees.push_back(_latestSmallTree);
-
-        // Reset the latest small tree to store the next small tree
-        _latestSmallTree = nullptr;
-
-        // If it's a conditional operator, create a new small tree
-        if(!_isConditional){
-            _isConditional = isConditional;
-            if(_isConditional){
-                // Create a new small tree base on the current token and value.
-                // This is done to ensure the presedence of the conditional statement whilst making sure that the next part of the condition is with correct precedence
-                _latestSmallTree = createTree(token, value);
-                _smallTrees.push_back(_latestSmallTree);
-                _latestSmallTree = nullptr;
+    }
+
+private:
+    // One line per statement: "[i] (op lhs rhs)". A missing child is '_'
+    void dumpTrees(const std::string& title){
+        _treeDump->write("#################### " + title + " ####################\n");
+        std::vector<std::pair<NodeIndex, char>> pending;                                        // A node to write, or a character if it's not 0
+        for(std::size_t i = 0; i < _trees.getStatementCount(); ++i){
+            _treeDump->write("[" + std::to_string(i) + "] ");
+            pending.push_back({_trees.getRoot(i), 0});
+            while(!pending.empty()){
+                auto [node, character] = pending.back();
+                pending.pop_back();
+                if(character != 0){
+                    _treeDump->write(character);
+                }else if(node == CompactTree::NullNode){
+                    _treeDump->write('_');
+                }else if(_trees.getLeft(node) == CompactTree::NullNode && _trees.getRight(node) == CompactTree::NullNode){
+                    _treeDump->write(_trees.getValue(node));
+                }else{
+                    _treeDump->write('(');
+                    _treeDump->write(_trees.getValue(node));
+                    pending.push_back({CompactTree::NullNode, ')'});
+                    pending.push_back({_trees.getRight(node), 0});
+                    pending.push_back({CompactTree::NullNode, ' '});
+                    pending.push_back({_trees.getLeft(node), 0});
+                    pending.push_back({CompactTree::NullNode, ' '});
+                }
             }
+            _treeDump->write('\n');
         }
-        
-        return;
+    }
+
+// Program Image. A script that was compiled before is run from its image instead of being parsed again
+public:
+
+    // Replaces the trees with the image at `path`. False if there's no image made from that source
+    bool loadImage(const std::string& path, uint64_t sourceHash, uint64_t sourceSize){
+        resetStatement();
+        _invalidStatements.clear();
+        return ProgramImage::load(path, _trees, sourceHash, sourceSize);
+    }
+
+    // Only worth it once the script passed the syntax analyzer. A script with errors never gets to run from an image
+    bool saveImage(const std::string& path, uint64_t sourceHash, uint64_t sourceSize) const{
+        return ProgramImage::save(path, _trees, sourceHash, sourceSize);
+    }
+
+// Others
+public:
+
+    
+    void print(){
+        for(std::size_t i = 0; i < _trees.getStatementCount(); ++i){
+            NodeIndex tree = _trees.getRoot(i);
+            std::cout << "\n#################### Totality [" << i << "] ####################\n";
+            printBT(tree);
+            std::cout << "#################### Summary [" << i << "] ####################\n";
+            std::cout << summarizeTree(tree) << '\n';
+            std::cout << "#################### Summarized [" << i << "] ####################\n";
+        }
+        std::cout << "TESTING" << std::endl;
+    }
+
+    // Avoids growing the compact tree while parsing a source of that many bytes. A node takes at least a byte, usually more with the whitespace
+    void reserveFor(std::size_t sourceSize){
+        _trees.reserve(sourceSize / 2);
+    }
+
+    const CompactTree& getTrees() const{
+        return _trees;
     }
 
 // Others
 private:
 
     // Summarize and get all the  value of the tree
-    std::string summarizeTree(AuxillaryTree* &tree){
+    std::string summarizeTree(NodeIndex tree){
         std::string total_string = "";
-        if(tree == nullptr){
+        if(tree == CompactTree::NullNode){
             return total_string;
         }
-        total_string += summarizeTree(tree->_left);
-        total_string += tree->_value;
-        total_string += summarizeTree(tree->_right);
+        total_string += summarizeTree(_trees.getLeft(tree));
+        total_string += _trees.getValue(tree);
+        total_string += summarizeTree(_trees.getRight(tree));
         return total_string;
     }
     
     // Auxillaray function to summarize the value of the tree
-    void summarizeTreeValue(AuxillaryTree* &tree){
-        if(tree == nullptr){
+    void summarizeTreeValue(NodeIndex tree){
+        if(tree == CompactTree::NullNode){
             return;
         }
-        summarizeTreeValue(tree->_left);
-        summarizeTreeValue(tree->_right);
+        summarizeTreeValue(_trees.getLeft(tree));
+        summarizeTreeValue(_trees.getRight(tree));
     }
  
-    // Auxillary function to evaluate the tree
-    bool evaluateTree(AuxillaryTree*& tree){
-        if(tree == nullptr){
-            return true;
-        }
-        //std::cout << "[PROCESSING] " << tree->_value << '\n';
-        _file << _languageDictionary->token_to_String[tree->_token] << ": " << tree->_value << '\n';
-        bool process = processEvaluation(tree);
-        bool lhs = evaluateTree(tree->_left);
-        bool rhs = evaluateTree(tree->_right);
-
-        if(!process || !lhs || !rhs){
-            return false;
-        }
-        return true;
-    }
-    
-    // Auxillary Function to process evaluation
-    bool processEvaluation(AuxillaryTree* &tree){
-        bool isCorrect = false;
-        switch(tree->_token){
-            case LanguageToken::CharacterToken:
-            case LanguageToken::IdentifierToken:
-            case LanguageToken::NumberToken:
-            case LanguageToken::StringToken:
-            case LanguageToken::NumberIntegerToken:
-            case LanguageToken::NumberDoubleToken:
-            case LanguageToken::LiteralToken:
-            case LanguageToken::OutputToken:
-            case LanguageToken::InputToken:
-                if(this->expect(tree, &AST::isNull)){
-                    isCorrect = true;
-                }
-                break;
-            case LanguageToken::AdditionToken:
-            case LanguageToken::SubtractionToken:
-            case LanguageToken::MultiplicationToken:
-            case LanguageToken::DivisionToken:
-            case LanguageToken::AssignmentToken:
-            case LanguageToken::LessThanToken:
-            case LanguageToken::GreaterThanToken:
-            case LanguageToken::EqualityToken:
-            case LanguageToken::NotEqualToken:
-                if(this->expect(tree, &AST::isMathematical)){
-                    isCorrect = true;
-                }
-                break;
-            case LanguageToken::ColonToken:
-                // Consider only the left side of the tree
-                if(this->expect(tree, &AST::isIdentifier, &AST::isNull)){
-                    isCorrect = true;
-                }
-                break;
-            case LanguageToken::LeftShiftToken:
-                if(this->expect(tree, &AST::isKeyword ,&AST::isPrintable)){
-                    isCorrect = true;
-                }
-                break;
-            case LanguageToken::RightShiftToken:
-                if(this->expect(tree, &AST::isKeyword ,&AST::isInputable)){
-                    isCorrect = true;
-                }
-                break;
-            case LanguageToken::IfToken:
-                if(this->expect(tree, &AST::isConditional, &AST::isAStatement)){
-                    isCorrect = true;
-                }
-                break;
-            case LanguageToken::TypeIntegerToken:
-            case LanguageToken::TypeDoubleToken:
-            case LanguageToken::TypeStringToken:
-                // Consider only the left side of the tree
-                if(this->expect(tree, &AST::declarable,1)){
-                    isCorrect = true;
-                }
-                break;
-            // Non-Existent or Non-Essential Tokens
-            case LanguageToken::EqualToken:
-                throw std::runtime_error("Equal Token is not a valid token. Please Check the Lexer");
-                break;
-            case LanguageToken::RootNode:
-                std::cout << "[DEBUG] Reach Root Node" << std::endl;
-                break;
-            case LanguageToken::OpenParenthesisToken:
-                throw std::runtime_error("Open Parenthesis should not be in the Tree. Please Check the Lexer");
-                break;
-            case LanguageToken::CloseParenthesisToken:
-                throw std::runtime_error("Close Parenthesis should not be in the Tree. Please Check the Lexer");
-                break;
-            case LanguageToken::QuoteToken:
-                throw std::runtime_error("Quote Token Should not be in the Tree. Please Check the Lexer");
-                break;
-            case LanguageToken::InvalidToken:
-                throw std::runtime_error("Invalid Token");
-                break;
-            default:
-                break;
-        }
-        if(!isCorrect){
-            _errorHandler->addError(tree->_value, tree->_line, tree->_column);
-            return false;
-        }
-        return true;
-    }
-
-    // Ease up the function call for evaluation
-    bool expect(AuxillaryTree* tree, bool (AST::*function)(AuxillaryTree*), int pathway = 2){
-        if(pathway == 3){
-            if((this->*function)(tree->_left) || (this->*function)(tree->_right)){
-                return true;
+    // What walking some statements produced. Kept aside so that several can be walked at once and logged in order
+    struct Validation{
+        std::vector<Diagnostic>     _errors;                                                    // Broken nodes, in the order they were found
+        std::string                 _trace;                                                     // Symbol trace of every node walked
+        std::exception_ptr          _failure;                                                   // Stopped the walk. Thrown once the rest is logged
+        std::vector<std::pair<NodeIndex, int>> _pendingNodes;                                   // Nodes left to visit, with their line
+    };
+
+    // Walks the tree before order and keeps every node that breaks its rule. Walked with a stack, expressions can be deeper than the call stack
+    // A '{' is reported on the line of its statement, the rest of the body on the lines of theirs
+    bool evaluateTree(NodeIndex tree, int line, Validation& validation) const{
+        bool isCorrect = true;
+        std::vector<std::pair<NodeIndex, int>>& pending = validation._pendingNodes;
+        pending.clear();
+        pending.push_back({tree, line});
+        while(!pending.empty()){
+            auto [node, nodeLine] = pending.back();
+            pending.pop_back();
+            if(node == CompactTree::NullNode){
+                continue;
             }
-        }
-        else if(pathway == 2){
-            if((this->*function)(tree->_left) && (this->*function)(tree->_right)){
-                return true;
+            int leftLine = nodeLine;
+            if(_trees.getToken(node) == LanguageToken::OpenBraceToken){
+                leftLine = _trees.getBodyLine(_trees.getLeft(node), nodeLine);
             }
-        }else if(pathway == 1){
-            if((this->*function)(tree->_left)){
-                return true;
+            if(_symbolTrace != nullptr){
+                writeSymbolTrace(node, validation._trace);
             }
-        }else if(pathway == 0){
-            if((this->*function)(tree->_right)){
-                return true;
+            if(!processEvaluation(node)){
+                validation._errors.push_back({std::string(_trees.getValue(node)), leftLine, _trees.getColumn(node), true});
+                isCorrect = false;
             }
+            pending.push_back({_trees.getRight(node), nodeLine});
+            pending.push_back({_trees.getLeft(node), leftLine});
         }
-        
-        return false;
-    }
-    
-    // Cases where the function needs to evaluate lhs and rhs seperately
-    bool expect(AuxillaryTree* tree, bool (AST::*lhs_func)(AuxillaryTree*), bool (AST::*rhs_func)(AuxillaryTree*)){
-        if((this->*lhs_func)(tree->_left) && (this->*rhs_func)(tree->_right)){
-            return true;
-        }
-        return false;
+        return isCorrect;
     }
 
-// Auxillary Evaluators
-private:
-    bool isLiteralOrIdentifier(AuxillaryTree* tree){
-        if(tree == nullptr){
-            return false;
-        }
-        bool firstRule = tree->_token == LanguageToken::LiteralToken;
-        bool secondRule = tree->_token == LanguageToken::IdentifierToken;
-        bool thirdRule = tree->_token == LanguageToken::NumberIntegerToken;
-        bool fourthRule = tree->_token == LanguageToken::NumberDoubleToken;
-        if(firstRule || secondRule || thirdRule || fourthRule){
-            return true;
-        }
-        return false;
-    }
-    bool isIdentifier(AuxillaryTree* tree){
-        if(tree == nullptr){
-            return false;
-        }
-        bool firstRule = tree->_token == LanguageToken::IdentifierToken;
-        if(firstRule){
-            return true;
-        }
-        return false;
-    }
-    bool isConditional(AuxillaryTree* tree){
-        if(tree == nullptr){
-            return false;
+    // Logs what a walk produced. Only called from the thread that owns the ErrorHandler and the trace
+    void reportValidation(Validation& validation){
+        for(const Diagnostic& diagnostic : validation._errors){
+            _errorHandler->addError(diagnostic);
         }
-        bool firstRule = tree->_token == LanguageToken::LessThanToken;
-        bool secondRule = tree->_token == LanguageToken::GreaterThanToken;
-        bool thirdRule = tree->_token == LanguageToken::EqualityToken;
-        bool fourthRule = tree->_token == LanguageToken::NotEqualToken;
-        if(firstRule || secondRule || thirdRule || fourthRule){
-            return true;
+        if(_symbolTrace != nullptr){
+            _symbolTrace->write(validation._trace);
         }
-        return false;
-    }
-    bool isAStatement(AuxillaryTree* tree){
-        if(tree == nullptr){
-            return false;
-        }
-        bool firstRule = tree->_token == LanguageToken::AssignmentToken;
-        bool secondRule = tree->_token == LanguageToken::ColonToken;
-        bool thirdRule = tree->_token == LanguageToken::LeftShiftToken;
-        bool fourthRule = tree->_token == LanguageToken::IfToken;
-        if(firstRule || secondRule || thirdRule || fourthRule){
-            return true;
+        if(validation._failure != nullptr){
+            std::rethrow_exception(validation._failure);
         }
-        return false;
     }
-    bool isNull(AuxillaryTree* tree){
-        if(tree == nullptr){
-            return true;
+
+    /**
+     * Text:    "<Token>: <value>\n" per node
+     * Binary:  "HLSY", uint32 version, then per node: uint8 token, uint32 value length, value bytes. Integers are little endian.
+     *          The token is the LanguageToken value, so token_to_String gives its name.
+    **/
+    void writeSymbolTrace(NodeIndex tree, std::string& trace) const{
+        std::string_view value = _trees.getValue(tree);
+        if(_isSymbolTraceBinary){
+            uint32_t size = (uint32_t)value.size();
+            char bytes[5] = {(char)_trees.getToken(tree), (char)(size & 0xFF), (char)((size >> 8) & 0xFF), (char)((size >> 16) & 0xFF), (char)((size >> 24) & 0xFF)};
+            trace.append(bytes, sizeof(bytes));
+            trace += value;
+            return;
         }
-        return false;
+        trace += LanguageDictionary::token_to_String[_trees.getToken(tree)];
+        trace += ": ";
+        trace += value;
+        trace += '\n';
     }
 
-    bool isMathematical(AuxillaryTree *tree){
-        if(tree == nullptr){
-            return false;
+    // Same as isValidNode(), but tokens that can't be in a tree stop the evaluation
+    bool processEvaluation(NodeIndex tree) const{
+        const NodeRule& rule = _nodeRules[_trees.getToken(tree)];
+        if(rule._exception != nullptr){
+            throw std::runtime_error(rule._exception);
         }
-        bool firstRule = tree->_token == LanguageToken::LiteralToken;
-        bool secondRule = tree->_token == LanguageToken::IdentifierToken;
-        bool thirdRule = tree->_token == LanguageToken::NumberIntegerToken;
-        bool fourthRule = tree->_token == LanguageToken::NumberDoubleToken;
-        bool fifthRule = tree->_token == LanguageToken::AdditionToken;
-        bool sixthRule = tree->_token == LanguageToken::SubtractionToken;
-        bool seventhRule = this->isMultiplicationOrDivision(tree->_token);
-        //bool seventhRule = tree->_token == LanguageToken::MultiplicationToken;
-        // We can add Strings
-        bool eightRule= tree->_token == LanguageToken::StringToken;
-        if(firstRule || secondRule || thirdRule || fourthRule || fifthRule || sixthRule || seventhRule || eightRule){
-            return true;
+        if(_trees.getToken(tree) == LanguageToken::RootNode){
+            std::cout << "[DEBUG] Reach Root Node" << std::endl;
         }
-        return false;
+        return isValidNode(tree);
     }
 
-    bool isPrintable(AuxillaryTree *tree){
-        if(tree == nullptr){
-            return false;
-        }
-        bool firstRule = isMathematical(tree);
-        bool secondRule = tree->_token == LanguageToken::StringToken;
-        if(firstRule || secondRule){
-            return true;
-        }
-        return false;
+/**
+ * Grammar Rules
+ * - Every token has a rule for the tokens its children can have. A set of tokens is a bit mask, so a rule is checked with three ANDs.
+ * - A node only depends on its own children, so it's checked as soon as the parser adds it. evaluateTree() only has to walk
+ *   the statements with a broken node, to report them in the same order as before.
+ * - The null node is a class of its own, it's never mistaken for a token.
+**/
+private:
+    using TokenSet = uint64_t;
+
+    static constexpr TokenSet NullSet           = (TokenSet)1 << 63;                              // The null node
+    static constexpr TokenSet AnySet            = ~(TokenSet)0;                                     // Not checked
+    static constexpr std::size_t RuleCount      = LanguageDictionary::TokenCount;                   // One rule per token
+
+    static_assert(LanguageDictionary::TokenCount < 63, "A TokenSet has one bit per token and the top bit for the null node");
+
+    struct NodeRule{
+        TokenSet    _left           = 0;                                                            // What the lhs can be. 0 never matches
+        TokenSet    _right          = 0;                                                            // What the rhs can be
+        TokenSet    _leftOfLeft     = AnySet;                                                       // What the lhs of the lhs can be. Only for declarations
+        const char* _exception      = nullptr;                                                      // Thrown if the token is in a tree at all
+    };
+
+    static const std::array<NodeRule, RuleCount> _nodeRules;
+
+    template<typename... Tokens>
+    static constexpr TokenSet tokenSet(Tokens... tokens){
+        return (TokenSet(0) | ... | ((TokenSet)1 << tokens));
     }
 
-    bool isInputable(AuxillaryTree *tree){
-        if(tree == nullptr){
-            return false;
-        }
-        bool firstRule = tree->_token == LanguageToken::IdentifierToken;
-        if(firstRule){
-            return true;
+    static constexpr std::array<NodeRule, RuleCount> buildNodeRules(){
+        constexpr TokenSet mathematical = tokenSet(LanguageToken::LiteralToken, LanguageToken::IdentifierToken, LanguageToken::NumberIntegerToken,
+                                                   LanguageToken::NumberDoubleToken, LanguageToken::AdditionToken, LanguageToken::SubtractionToken,
+                                                   LanguageToken::MultiplicationToken, LanguageToken::DivisionToken, LanguageToken::StringToken);
+        constexpr TokenSet keyword      = tokenSet(LanguageToken::IfToken, LanguageToken::OutputToken, LanguageToken::InputToken);
+        constexpr TokenSet conditional  = tokenSet(LanguageToken::LessThanToken, LanguageToken::GreaterThanToken, LanguageToken::EqualityToken, LanguageToken::NotEqualToken);
+        constexpr TokenSet statement    = tokenSet(LanguageToken::AssignmentToken, LanguageToken::ColonToken, LanguageToken::LeftShiftToken, LanguageToken::IfToken);
+        constexpr TokenSet identifier   = tokenSet(LanguageToken::IdentifierToken);
+        constexpr TokenSet body         = tokenSet(LanguageToken::OpenBraceToken) | NullSet;
+        constexpr TokenSet declaration  = tokenSet(LanguageToken::TypeIntegerToken, LanguageToken::TypeDoubleToken, LanguageToken::TypeStringToken);
+
+        std::array<NodeRule, RuleCount> rules{};
+
+        // Operands
+        for(LanguageToken token : {LanguageToken::CharacterToken, LanguageToken::IdentifierToken, LanguageToken::NumberToken, LanguageToken::StringToken,
+                                   LanguageToken::NumberIntegerToken, LanguageToken::NumberDoubleToken, LanguageToken::LiteralToken,
+                                   LanguageToken::OutputToken, LanguageToken::InputToken}){
+            rules[token] = {NullSet, NullSet};
         }
-        return false;
-    }
 
-    bool declarable(AuxillaryTree *tree){
-        if(tree == nullptr){
-            return false;
+        // Operators take an expression on both sides
+        for(LanguageToken token : {LanguageToken::AdditionToken, LanguageToken::SubtractionToken, LanguageToken::MultiplicationToken,
+                                   LanguageToken::DivisionToken, LanguageToken::AssignmentToken, LanguageToken::LessThanToken,
+                                   LanguageToken::GreaterThanToken, LanguageToken::EqualityToken, LanguageToken::NotEqualToken}){
+            rules[token] = {mathematical, mathematical};
         }
 
-        bool firstRule = tree->_token == LanguageToken::ColonToken;
-        bool secondRule = tree->_left->_token == LanguageToken::IdentifierToken;
-        if (firstRule && secondRule){
-            return true;
+        rules[LanguageToken::ColonToken]            = {identifier, NullSet};
+        rules[LanguageToken::LeftShiftToken]        = {keyword, mathematical};
+        rules[LanguageToken::RightShiftToken]       = {keyword, identifier};
+        rules[LanguageToken::IfToken]               = {conditional, statement};
+        rules[LanguageToken::WhileToken]            = {conditional, body};
+        rules[LanguageToken::OpenBraceToken]        = {statement | declaration | tokenSet(LanguageToken::WhileToken), body};
+
+        // Declarations. Only the ':' and the identifier under it are checked
+        for(LanguageToken token : {LanguageToken::TypeIntegerToken, LanguageToken::TypeDoubleToken, LanguageToken::TypeStringToken}){
+            rules[token] = {tokenSet(LanguageToken::ColonToken), AnySet, identifier};
         }
-        return false;
+
+        // Non-Existent or Non-Essential Tokens
+        rules[LanguageToken::EqualToken]._exception             = "Equal Token is not a valid token. Please Check the Lexer";
+        rules[LanguageToken::OpenParenthesisToken]._exception   = "Open Parenthesis should not be in the Tree. Please Check the Lexer";
+        rules[LanguageToken::CloseParenthesisToken]._exception  = "Close Parenthesis should not be in the Tree. Please Check the Lexer";
+        rules[LanguageToken::CloseBraceToken]._exception        = "Close Brace should not be in the Tree. Please Check the Lexer";
+        rules[LanguageToken::QuoteToken]._exception             = "Quote Token Should not be in the Tree. Please Check the Lexer";
+        rules[LanguageToken::InvalidToken]._exception           = "Invalid Token";
+        return rules;
     }
-    
-    bool isKeyword(AuxillaryTree* tree){
-        if(tree == nullptr){
-            return false;
-        }
-        bool firstRule = tree->_token == LanguageToken::IfToken;
-        bool secondRule = tree->_token == LanguageToken::OutputToken;
-        bool thirdRule = tree->_token == LanguageToken::InputToken;
-        if(firstRule || secondRule || thirdRule){
-            return true;
-        }
-        return false;
+
+    TokenSet tokenSetOf(NodeIndex tree) const{
+        return tree == CompactTree::NullNode ? NullSet : (TokenSet)1 << _trees.getToken(tree);
     }
-    bool isComparable(AuxillaryTree* tree){
-        if(tree == nullptr){
-            return false;
-        }
-        bool firstRule = isMathematical(tree);
-        bool secondRule = tree->_token == LanguageToken::StringToken;
-        if(firstRule || secondRule){
-            return true;
-        }
-        return false;
+
+    // If the children of the node are what its token allows
+    bool isValidNode(NodeIndex tree) const{
+        const NodeRule& rule = _nodeRules[_trees.getToken(tree)];
+        NodeIndex left = _trees.getLeft(tree);
+        return (rule._left & tokenSetOf(left)) != 0
+            && (rule._right & tokenSetOf(_trees.getRight(tree))) != 0
+            && (rule._leftOfLeft & tokenSetOf(_trees.getLeft(left))) != 0;
     }
 
 private:
 
     // Reference: https://stackoverflow.com/questions/36802354/print-binary-tree-in-a-pretty-way-using-c
-    void printBT(const std::string& prefix, const AuxillaryTree* node, bool isLeft)
+    void printBT(const std::string& prefix, NodeIndex node, bool isLeft)
     {
-        if( node != nullptr )
+        if( node != CompactTree::NullNode )
         {
             std::cout << prefix;
 
             std::cout << (isLeft ? "├──" : "└──" );
 
             // print the value of the node
-            std::cout << node->_value << std::endl;
+            std::cout << _trees.getValue(node) << std::endl;
 
             // enter the next tree level - left and right branch
-            printBT( prefix + (isLeft ? "│   " : "    "), node->_left, true);
-            printBT( prefix + (isLeft ? "│   " : "    "), node->_right, false);
+            printBT( prefix + (isLeft ? "│   " : "    "), _trees.getLeft(node), true);
+            printBT( prefix + (isLeft ? "│   " : "    "), _trees.getRight(node), false);
         }
     }
 
-    void printBT(const AuxillaryTree* node)
+    void printBT(NodeIndex node)
     {
         printBT("", node, false);    
     }
 
-    bool isDoubleOperator(std::string value){
-        auto alphabet = _languageDictionary->getDoubleOperator();
-        return alphabet.find(value) != alphabet.end();
-
-    }
-    bool isOperator(std::string value){
-        auto alphabet = _languageDictionary->getOperatorAlphabet();
-        return alphabet.find(value) != alphabet.end();
-    }
-
-    bool isKeyword(std::string value){
-        auto alphabet = _languageDictionary->getLanguageKeywords();
-        return alphabet.find(value) != alphabet.end();
-    }
-
-    bool isConditionalOperator(std::string value){
-        auto alphabet = _languageDictionary->getConditionalOperator();
-        return alphabet.find(value) != alphabet.end();
-    }
-
-    bool isMultiplicationOrDivision(LanguageToken token){
-        return token == LanguageToken::MultiplicationToken || token == LanguageToken::DivisionToken;
-    }
-
-// Quality of Life
-private:
-    AuxillaryTree* createTree(LanguageToken token, std::string value){
-        AuxillaryTree* tree = new AuxillaryTree(token, value, _line, _column);
-        tree->_token = token;
-        tree->_value = value;
-        return tree;
-    }
-    AuxillaryTree* createTree(LanguageToken token, std::string value, int line, int column){
-        AuxillaryTree* tree = new AuxillaryTree(token, value, line, column);
-        tree->_token = token;
-        tree->_value = value;
-        return tree;
-    }
-    bool addToAvailableBranchL(AuxillaryTree* &tree, LanguageToken &token, std::string &value){
-        if(tree->_left== nullptr){
-            tree->_left = createTree(token, value);
-            return true;
-        }else if(tree->_right == nullptr){
-            tree->_right = createTree(token, value);
-            return true;
-        }
-        return false;
-    }
-    bool addToAvailableBranchL(AuxillaryTree* &tree, AuxillaryTree* &rhs){
-        if(tree->_left== nullptr){
-            tree->_left = rhs;
-            return true;
-        }else if(tree->_right == nullptr){
-            tree->_right = rhs;
-            return true;
-        }
-        return false;
-    }
-
-    bool addToAvailableBranchR(AuxillaryTree* &tree, LanguageToken &token, std::string &value){
-        if(tree->_right == nullptr){
-            tree->_right = createTree(token, value);
-            return true;
-        }else if(tree->_left == nullptr){
-            tree->_left = createTree(token, value);
-            return true;
-        }
-        return false;
-    }
-    bool addToAvailableBranchR(AuxillaryTree* &tree, AuxillaryTree* &rhs){
-        if(tree->_right == nullptr){
-            tree->_right = rhs;
-            return true;
-        }else if(tree->_left == nullptr){
-            tree->_left = rhs;
-            return true;
-        }
-        return false;
-    }
-
-    bool exhaustRightBranch(AuxillaryTree* tree, LanguageToken &token, std::string &value){
-        while(tree->_right != nullptr){
-            tree = tree->_right;
-        }
-        if(tree->_right == nullptr){
-            tree->_right = createTree(token, value);
-            return true;
-        }
-        return false;
-    }
-    bool exhaustRightBranch(AuxillaryTree* tree, AuxillaryTree *rhs){
-        while(tree->_right != nullptr){
-            tree = tree->_right;
-        }
-        if(tree->_right == nullptr){
-            tree->_right = rhs;
-            return true;
-        }
-        return false;
-    }
-
-    AuxillaryTree* replaceParentToLeftOf(AuxillaryTree* tree, LanguageToken &token, std::string &value){
-        AuxillaryTree* newTree = createTree(token, value, tree->_line, tree->_column);
-        newTree->_left = tree;
-        tree = newTree;
-        return tree;
-    }
-
 };
 
+inline constexpr std::array<AST::NodeRule, AST::RuleCount> AST::_nodeRules = AST::buildNodeRules();
+
 #endif // ABSTRACTSYNTAXTREE_h
 
@@ -0,0 +1,441 @@
+#ifndef COMPACTTREE_H
+#define COMPACTTREE_H
+
+// Standard Libraries
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Created Classes
+#include "../LanguageDictionary/LanguageDictionary.h"
+#include "../LexicalAnalyzer/token.h"
+#include "../SourceBuffer/sourceBuffer.h"
+#include "../NumberText/numberText.h"
+#include "TreeArena.h"
+
+/**
+ * Compact Tree
+ * - Every statement tree of a script, stored as parallel arrays. A node is an index into the arrays. Index 0 is the null node.
+ * - A node is its token (1 byte), its type (1 byte), the index of both children, the index of its spelling and its column. 18 bytes in total.
+ *   The type is Unknown until TypeChecker sets it.
+ * - Spellings are stored once however often they appear. Number literals keep the value the lexer converted next to their spelling.
+ * - Every distinct identifier gets a slot when it's first added: 0, 1, 2... The interpreter finds its variable by slot instead of by name.
+ * - Lines are kept per statement. The lexer counts lines by ';', so every node of a statement is on the line of the statement.
+ *   A statement of a while body is on a line of its own, kept on the side by its root as the lines after its while (see getBodyLine).
+ *   So a while parsed on its own, as the watch mode does, has the same body lines wherever it is in the script.
+ * - Nodes are only ever added, children before their parent. A statement is the index of its root.
+ * - The getters read through Arrays. While the tree is built they point into its vectors. A tree loaded from a program image
+ *   (see ProgramImage) points into the mapped file instead and can't be added to.
+**/
+class CompactTree{
+
+public:
+    using NodeIndex = uint32_t;
+    static constexpr NodeIndex NullNode = 0;                                // A missing child. Its token is InvalidToken
+    static constexpr uint32_t NoSlot = UINT32_MAX;                          // The spelling isn't an identifier
+
+    // Static type of a node. What the interpreter evaluates it as
+    enum class ValueType : uint8_t{
+        Unknown,                                                            // Not checked yet, or a variable that is never declared
+        Integer,                                                            // Whole number. Variables of it are int, literals int64
+        Double,
+        String,
+        None,                                                               // A statement or a condition. Has no value
+        Invalid                                                             // Has a type error, reported by TypeChecker
+    };
+
+    struct Statement{
+        NodeIndex   _root;                                                  // Root of the statement. NullNode for an empty statement
+        uint32_t    _line;                                                  // Line of every node of the statement
+    };
+
+    // Every array of the tree, wherever it is stored
+    struct Arrays{
+        const uint8_t*              _tokens             = nullptr;
+        const ValueType*            _types              = nullptr;
+        const NodeIndex*            _left               = nullptr;
+        const NodeIndex*            _right              = nullptr;
+        const uint32_t*             _spellings          = nullptr;
+        const uint32_t*             _columns            = nullptr;
+        std::size_t                 _nodeCount          = 0;                // Including the null node
+        const std::string_view*     _spellingTable      = nullptr;
+        const NumericValue*         _spellingNumbers    = nullptr;
+        const uint32_t*             _spellingSlots      = nullptr;
+        std::size_t                 _spellingCount      = 0;
+        const Statement*            _statements         = nullptr;
+        std::size_t                 _statementCount     = 0;
+        const Statement*            _bodyStatements     = nullptr;
+        std::size_t                 _bodyStatementCount = 0;
+        std::size_t                 _slotCount          = 0;
+    };
+
+private:
+    using LanguageToken = LanguageDictionary::LanguageToken;
+
+    static constexpr uint32_t NoSpelling = UINT32_MAX;                      // The token wasn't seen yet
+    static constexpr double LargestExactInteger = 9007199254740992.0;      // 2^53. Every whole number below it is exact in a double
+
+private:
+    // One entry per node
+    std::vector<uint8_t>                            _tokens;                // LanguageToken of the node
+    std::vector<ValueType>                          _types;                 // Static type of the node
+    std::vector<NodeIndex>                          _left;                  // Left child
+    std::vector<NodeIndex>                          _right;                 // Right child
+    std::vector<uint32_t>                           _spellings;             // Index of the spelling in _spellingTable
+    std::vector<uint32_t>                           _columns;               // Column of the token the node was made from
+
+    // One entry per distinct spelling
+    std::vector<std::string_view>                   _spellingTable;         // Spellings. The text is owned by _text
+    std::vector<NumericValue>                       _spellingNumbers;       // Value of the spelling if it's a number literal
+    std::vector<uint32_t>                           _spellingSlots;         // Slot of the spelling if it's an identifier
+    uint32_t                                        _slotCount;             // Slots given out so far
+    std::unordered_map<std::string_view, uint32_t>  _spellingIndex;         // Spelling to its index in _spellingTable
+    TreeArena                                       _text;                  // Owns the text of the spellings
+    uint32_t                                        _fixedSpellings[256];   // Spelling of the operators and keywords, by token. Saves the hash lookup
+
+    std::vector<Statement>                          _statements;            // Every statement, in source order
+    std::vector<Statement>                          _bodyStatements;        // Every statement of a while body, with the lines after its while. Sorted by root, roots only grow
+
+    Arrays                                          _arrays;                // What the getters read
+    std::unique_ptr<SourceBuffer>                   _image;                 // The program image the arrays point into, if one is attached
+
+// Constructors
+public:
+    CompactTree(){
+        clear();
+    }
+
+    // The spellings point into _text, so the tree can't be copied
+    CompactTree(CompactTree const&) = delete;
+    void operator=(CompactTree const&) = delete;
+
+// Methods
+public:
+
+    // The children have to be added first. The value is copied, so it doesn't have to outlive the call
+    NodeIndex addNode(LanguageToken token, NodeIndex left, NodeIndex right, std::string_view value, NumericValue number, int column){
+        uint32_t spelling = spellingOf(token, value, number);
+        if(token == LanguageToken::IdentifierToken && _spellingSlots[spelling] == NoSlot){
+            _spellingSlots[spelling] = _slotCount++;
+            _arrays._slotCount = _slotCount;
+        }
+
+        // The spelling may have been seen first as something that isn't a number, e.g. the text of a string
+        if(token == LanguageToken::NumberIntegerToken || token == LanguageToken::NumberDoubleToken){
+            _spellingNumbers[spelling] = number;
+        }
+        return pushNode(token, left, right, spelling, column);
+    }
+
+    // Only for a tree that isn't attached to an image
+    void setType(NodeIndex node, ValueType type){
+        _types[node] = type;
+    }
+
+    // Same token, spelling and column as `node`, with other children
+    NodeIndex copyNode(NodeIndex node, NodeIndex left, NodeIndex right){
+        return pushNode(getToken(node), left, right, _spellings[node], getColumn(node));
+    }
+
+    /**
+     * A number literal for a value that wasn't in the script. Spelled the shortest way that reads back as the same value,
+     * so equal values share their spelling.
+     * - A whole number below 2^53 (exact in a double) is an integer literal, anything else a double literal.
+     *   A double is always spelled like one ("-0.0", not "-0"), since a spelling has one number for every token that uses it.
+    **/
+    NodeIndex addNumber(double value, int column){
+        char spelling[NumberText::MaxLength + 2];
+        NumericValue number;
+        LanguageToken token;
+        char* end;
+        if(value == std::trunc(value) && std::fabs(value) < LargestExactInteger && !(value == 0.0 && std::signbit(value))){
+            token = LanguageToken::NumberIntegerToken;
+            number._integer = (int64_t)value;
+            end = NumberText::writeInteger(spelling, number._integer);
+        }else{
+            token = LanguageToken::NumberDoubleToken;
+            number._double = value;
+            end = NumberText::writeDouble(spelling, value, NumberText::ShortestFormat);
+            if(std::string_view(spelling, (std::size_t)(end - spelling)).find_first_of(".e") == std::string_view::npos){
+                *end++ = '.';
+                *end++ = '0';
+            }
+        }
+        return addNode(token, NullNode, NullNode, std::string_view(spelling, (std::size_t)(end - spelling)), number, column);
+    }
+
+    void addStatement(NodeIndex root, int line){
+        _statements.push_back({root, (uint32_t)line});
+        refreshStatements();
+    }
+
+    // A statement of a while body, `lines` after its while. It has to be added as soon as its root is
+    void addBodyStatement(NodeIndex root, int lines){
+        _bodyStatements.push_back({root, (uint32_t)lines});
+        refreshStatements();
+    }
+
+    // Room for `nodes` nodes. Pages that are never written aren't backed by memory, so a generous guess only costs address space
+    void reserve(std::size_t nodes){
+        _tokens.reserve(nodes);
+        _types.reserve(nodes);
+        _left.reserve(nodes);
+        _right.reserve(nodes);
+        _spellings.reserve(nodes);
+        _columns.reserve(nodes);
+    }
+
+    // The nodes of the old root stay until clear()
+    void setRoot(std::size_t statement, NodeIndex root){
+        _statements[statement]._root = root;
+    }
+
+    // Forgets the last statement. Its nodes stay until clear()
+    NodeIndex popStatement(){
+        if(_statements.empty()){
+            return NullNode;
+        }
+        NodeIndex root = _statements.back()._root;
+        _statements.pop_back();
+        refreshStatements();
+        return root;
+    }
+
+    // Frees every node and every spelling. Every index given out before is invalid after this
+    void clear(){
+        std::vector<uint8_t>().swap(_tokens);
+        std::vector<ValueType>().swap(_types);
+        std::vector<NodeIndex>().swap(_left);
+        std::vector<NodeIndex>().swap(_right);
+        std::vector<uint32_t>().swap(_spellings);
+        std::vector<uint32_t>().swap(_columns);
+        std::vector<std::string_view>().swap(_spellingTable);
+        std::vector<NumericValue>().swap(_spellingNumbers);
+        std::vector<uint32_t>().swap(_spellingSlots);
+        _slotCount = 0;
+        std::unordered_map<std::string_view, uint32_t>().swap(_spellingIndex);
+        std::vector<Statement>().swap(_statements);
+        std::vector<Statement>().swap(_bodyStatements);
+        _text.release();
+        std::fill(std::begin(_fixedSpellings), std::end(_fixedSpellings), NoSpelling);
+        _image.reset();
+        _arrays = Arrays();
+        refreshStatements();
+
+        // The null node, so that a child index of 0 reads as an InvalidToken without any children
+        pushNode(LanguageToken::InvalidToken, NullNode, NullNode, intern(std::string_view(), {0}), 0);
+    }
+
+    // Number of nodes in a tree
+    std::size_t countNodes(NodeIndex node) const{
+        if(node == NullNode){
+            return 0;
+        }
+        return 1 + countNodes(_arrays._left[node]) + countNodes(_arrays._right[node]);
+    }
+
+    /**
+     * Reads the tree from a program image instead of the vectors. Everything that was in the tree is dropped.
+     * - The arrays have to point into `image`, which is kept alive until clear(). The spelling table is the only thing that isn't mapped,
+     *   since it points at the text of the spellings. The loaded tree is read only.
+    **/
+    void attach(const Arrays& arrays, std::vector<std::string_view> spellingTable, std::unique_ptr<SourceBuffer> image){
+        clear();
+        _spellingTable = std::move(spellingTable);
+        _image = std::move(image);
+        _arrays = arrays;
+        _arrays._spellingTable = _spellingTable.data();
+        _slotCount = (uint32_t)arrays._slotCount;
+    }
+
+    bool isAttached() const{
+        return _image != nullptr;
+    }
+
+// Getters
+public:
+    LanguageToken getToken(NodeIndex node) const{
+        return (LanguageToken)_arrays._tokens[node];
+    }
+
+    ValueType getType(NodeIndex node) const{
+        return _arrays._types[node];
+    }
+
+    NodeIndex getLeft(NodeIndex node) const{
+        return _arrays._left[node];
+    }
+
+    NodeIndex getRight(NodeIndex node) const{
+        return _arrays._right[node];
+    }
+
+    std::string_view getValue(NodeIndex node) const{
+        return _arrays._spellingTable[_arrays._spellings[node]];
+    }
+
+    // Only meaningful for NumberIntegerToken and NumberDoubleToken nodes
+    NumericValue getNumber(NodeIndex node) const{
+        return _arrays._spellingNumbers[_arrays._spellings[node]];
+    }
+
+    // Only meaningful for IdentifierToken nodes. The same name always has the same slot
+    uint32_t getSlot(NodeIndex node) const{
+        return _arrays._spellingSlots[_arrays._spellings[node]];
+    }
+
+    // Number of distinct identifiers
+    std::size_t getSlotCount() const{
+        return _slotCount;
+    }
+
+    // Name of every variable, by slot. Built from the spellings on every call, only for printing the variables
+    std::vector<std::string_view> getSlotNames() const{
+        std::vector<std::string_view> names(_slotCount);
+        for(std::size_t i = 0; i < _arrays._spellingCount; ++i){
+            if(_arrays._spellingSlots[i] != NoSlot){
+                names[_arrays._spellingSlots[i]] = _arrays._spellingTable[i];
+            }
+        }
+        return names;
+    }
+
+    int getColumn(NodeIndex node) const{
+        return (int)_arrays._columns[node];
+    }
+
+    std::size_t getStatementCount() const{
+        return _arrays._statementCount;
+    }
+
+    NodeIndex getRoot(std::size_t statement) const{
+        return _arrays._statements[statement]._root;
+    }
+
+    int getLine(std::size_t statement) const{
+        return (int)_arrays._statements[statement]._line;
+    }
+
+    // Line of the statement of a while body with that root, the left child of a '{' node. `line` is the line of its while,
+    // and what is returned if it isn't one, e.g. a statement a pass copied. Only looked up to report an error
+    int getBodyLine(NodeIndex root, int line) const{
+        const Statement* end = _arrays._bodyStatements + _arrays._bodyStatementCount;
+        const Statement* found = std::lower_bound(_arrays._bodyStatements, end, root, [](const Statement& statement, NodeIndex node){
+            return statement._root < node;
+        });
+        return found != end && found->_root == root ? line + (int)found->_line : line;
+    }
+
+    // Nodes of every statement, including the ones that were popped. The null node isn't counted
+    std::size_t getNodeCount() const{
+        return _arrays._nodeCount - 1;
+    }
+
+    // Bytes held by the arrays and the spellings
+    std::size_t getReservedBytes() const{
+        return _tokens.capacity() * sizeof(uint8_t)
+            + _types.capacity() * sizeof(ValueType)
+            + (_left.capacity() + _right.capacity()) * sizeof(NodeIndex)
+            + (_spellings.capacity() + _columns.capacity()) * sizeof(uint32_t)
+            + _spellingTable.capacity() * sizeof(std::string_view)
+            + _spellingNumbers.capacity() * sizeof(NumericValue)
+            + _spellingSlots.capacity() * sizeof(uint32_t)
+            + (_statements.capacity() + _bodyStatements.capacity()) * sizeof(Statement)
+            + _text.getReservedBytes()
+            + (_image != nullptr ? _image->size() : 0);
+    }
+
+    const Arrays& getArrays() const{
+        return _arrays;
+    }
+
+private:
+    // Operators and keywords are always spelled the same, so their spelling is looked up once per token
+    uint32_t spellingOf(LanguageToken token, std::string_view value, NumericValue number){
+        if(hasOwnSpelling(token)){
+            return intern(value, number);
+        }
+        uint32_t& spelling = _fixedSpellings[(uint8_t)token];
+        if(spelling == NoSpelling){
+            spelling = intern(value, number);
+        }
+        return spelling;
+    }
+
+    static bool hasOwnSpelling(LanguageToken token){
+        switch(token){
+            case LanguageToken::IdentifierToken:
+            case LanguageToken::StringToken:
+            case LanguageToken::NumberIntegerToken:
+            case LanguageToken::NumberDoubleToken:
+            case LanguageToken::NumberToken:
+            case LanguageToken::LiteralToken:
+            case LanguageToken::CharacterToken:
+            case LanguageToken::InvalidToken:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    NodeIndex pushNode(LanguageToken token, NodeIndex left, NodeIndex right, uint32_t spelling, int column){
+        NodeIndex index = (NodeIndex)_tokens.size();
+        _tokens.push_back((uint8_t)token);
+        _types.push_back(ValueType::Unknown);
+        _left.push_back(left);
+        _right.push_back(right);
+        _spellings.push_back(spelling);
+        _columns.push_back((uint32_t)column);
+        refreshNodes();
+        return index;
+    }
+
+    // The vectors may have moved. Cheaper than a branch in every getter
+    void refreshNodes(){
+        _arrays._tokens = _tokens.data();
+        _arrays._types = _types.data();
+        _arrays._left = _left.data();
+        _arrays._right = _right.data();
+        _arrays._spellings = _spellings.data();
+        _arrays._columns = _columns.data();
+        _arrays._nodeCount = _tokens.size();
+    }
+
+    void refreshSpellings(){
+        _arrays._spellingTable = _spellingTable.data();
+        _arrays._spellingNumbers = _spellingNumbers.data();
+        _arrays._spellingSlots = _spellingSlots.data();
+        _arrays._spellingCount = _spellingTable.size();
+    }
+
+    void refreshStatements(){
+        _arrays._statements = _statements.data();
+        _arrays._statementCount = _statements.size();
+        _arrays._bodyStatements = _bodyStatements.data();
+        _arrays._bodyStatementCount = _bodyStatements.size();
+    }
+
+    // Number literals set the number of their spelling in addNode(). The same spelling always has the same value
+    uint32_t intern(std::string_view value, NumericValue number){
+        auto found = _spellingIndex.find(value);
+        if(found != _spellingIndex.end()){
+            return found->second;
+        }
+        std::string_view stored = _text.copyString(value);
+        uint32_t index = (uint32_t)_spellingTable.size();
+        _spellingTable.push_back(stored);
+        _spellingNumbers.push_back(number);
+        _spellingSlots.push_back(NoSlot);
+        _spellingIndex.emplace(stored, index);
+        refreshSpellings();
+        return index;
+    }
+};
+
+#endif // COMPACTTREE_H
@@ -0,0 +1,252 @@
+#ifndef CONSTANTFOLDER_H
+#define CONSTANTFOLDER_H
+
+// Standard Libraries
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Created Classes
+#include "../LanguageDictionary/LanguageDictionary.h"
+#include "../LexicalAnalyzer/token.h"
+#include "CompactTree.h"
+
+/**
+ * Constant Folder
+ * - Runs once the trees are validated, before they are interpreted. Every change gives the same output as interpreting the tree as it was.
+ * - An operation on two numbers becomes a number, e.g. "3 * (5 + 2)" becomes "21". The interpreter does all arithmetic in double,
+ *   so the folder does too, in the same order. The result is added with CompactTree::addNumber().
+ * - Identities that hold for every double: "x * 1", "1 * x", "x / 1" and "x - 0" become "x".
+ *   "x + 0" is left alone, since -0 + 0 is 0 and "output" would show the difference.
+ * - A string literal printed by "output" gets its quotes stripped once, here, and becomes a LiteralToken.
+ * - Left to the interpreter: a division by zero, a result that isn't finite, and anything that would turn an operation into a bare
+ *   variable or string under "output", since those are printed differently than a number.
+ * - Trees are never changed in place. A node whose children changed is copied, the old one is left unused.
+ *   Nodes come before their parent and every statement is added after the one before it, so the nodes of a statement are the ones
+ *   after the root of the previous statement, up to its own root. Every node is visited once, in index order, without walking the trees,
+ *   and what is kept per node only has to be as large as a statement. So it has to run on the trees as the parser left them, before
+ *   any other pass adds nodes.
+ * - The value of a folded operation is kept on the side. It only becomes a literal node once something that isn't folded uses it,
+ *   so "1 + 2 * 3 - 4" adds one node, not three.
+**/
+class ConstantFolder{
+
+private:
+    using LanguageToken = LanguageDictionary::LanguageToken;
+    using NodeIndex = CompactTree::NodeIndex;
+
+private:
+    CompactTree&            _trees;                                         // The trees that are folded
+    NodeIndex               _first              = 1;                        // First node of the current statement. The arrays below start there
+    std::vector<NodeIndex>  _replacements;                                  // What every node was replaced with. Itself if it's unchanged
+    std::vector<double>     _values;                                        // Value of every folded node that isn't a literal node yet
+    std::vector<char>       _isFolded;                                      // If the node is only in _values so far
+    std::size_t             _foldedCount        = 0;                        // Operations replaced by their value
+    std::size_t             _identityCount      = 0;                        // Operations replaced by their operand
+    std::size_t             _stringCount        = 0;                        // Strings stripped of their quotes
+
+// Constructors
+public:
+    ConstantFolder(CompactTree& trees) : _trees(trees){}
+
+    ConstantFolder(ConstantFolder const&) = delete;
+    void operator=(ConstantFolder const&) = delete;
+
+// Methods
+public:
+    void run(){
+        _first = 1;
+        for(std::size_t i = 0; i < _trees.getStatementCount(); ++i){
+            NodeIndex root = _trees.getRoot(i);
+            if(root < _first){
+                continue;                                                   // Empty statement
+            }
+            std::size_t count = root - _first + 1;
+            _replacements.assign(count, CompactTree::NullNode);
+            _values.assign(count, 0.0);
+            _isFolded.assign(count, 0);
+            for(NodeIndex node = _first; node <= root; ++node){
+                _replacements[node - _first] = fold(node);
+            }
+            _trees.setRoot(i, replacementOf(root));
+            _first = root + 1;
+        }
+        std::vector<NodeIndex>().swap(_replacements);
+        std::vector<double>().swap(_values);
+        std::vector<char>().swap(_isFolded);
+    }
+
+    std::size_t getFoldedCount() const{
+        return _foldedCount;
+    }
+
+    std::size_t getIdentityCount() const{
+        return _identityCount;
+    }
+
+    std::size_t getStringCount() const{
+        return _stringCount;
+    }
+
+private:
+    // The replacement of the node. Only in _values if it was folded, nothing else uses it yet
+    NodeIndex fold(NodeIndex node){
+        LanguageToken token = _trees.getToken(node);
+        NodeIndex left = CompactTree::NullNode;
+        NodeIndex right = CompactTree::NullNode;
+
+        switch(token){
+            case LanguageToken::AdditionToken:
+            case LanguageToken::SubtractionToken:
+            case LanguageToken::MultiplicationToken:
+            case LanguageToken::DivisionToken:
+                {
+                    double lhs = 0.0;
+                    double rhs = 0.0;
+                    bool isLhsConstant = constantOf(_trees.getLeft(node), lhs);
+                    bool isRhsConstant = constantOf(_trees.getRight(node), rhs);
+                    if(isLhsConstant && isRhsConstant && foldOperation(token, lhs, rhs, _values[node - _first])){
+                        _isFolded[node - _first] = 1;
+                        return CompactTree::NullNode;
+                    }
+                    left = replacementOf(_trees.getLeft(node));
+                    right = replacementOf(_trees.getRight(node));
+                    NodeIndex operand = simplify(token, left, right, isLhsConstant, lhs, isRhsConstant, rhs);
+                    if(operand != CompactTree::NullNode){
+                        ++_identityCount;
+                        return operand;
+                    }
+                }
+                break;
+
+            // The operand of "output" is printed as it is. An operation can't be replaced by a variable or a string there
+            case LanguageToken::LeftShiftToken:
+                left = replacementOf(_trees.getLeft(node));
+                right = replacementOf(_trees.getRight(node));
+                if(_trees.getToken(right) == LanguageToken::StringToken){
+                    right = stripQuotes(right);
+                }else if(isPrintedDifferently(right) && !isPrintedDifferently(_trees.getRight(node))){
+                    right = keepOperation(_trees.getRight(node));
+                }
+                break;
+            default:
+                left = replacementOf(_trees.getLeft(node));
+                right = replacementOf(_trees.getRight(node));
+                break;
+        }
+
+        if(left == _trees.getLeft(node) && right == _trees.getRight(node)){
+            return node;
+        }
+        return _trees.copyNode(node, left, right);
+    }
+
+    // A folded node becomes a literal node the first time it's asked for
+    NodeIndex replacementOf(NodeIndex node){
+        if(node == CompactTree::NullNode){
+            return node;
+        }
+        std::size_t i = node - _first;
+        if(_isFolded[i] != 0){
+            _isFolded[i] = 0;
+            _replacements[i] = _trees.addNumber(_values[i], _trees.getColumn(node));
+        }
+        return _replacements[i];
+    }
+
+    // Value of a folded node or a number literal. A missing operand counts as 0, like in the interpreter
+    bool constantOf(NodeIndex original, double& value) const{
+        if(original == CompactTree::NullNode){
+            value = 0.0;
+            return true;
+        }
+        std::size_t i = original - _first;
+        if(_isFolded[i] != 0){
+            value = _values[i];
+            return true;
+        }
+        NodeIndex node = _replacements[i];
+        switch(_trees.getToken(node)){
+            case LanguageToken::NumberIntegerToken:
+                value = (double)_trees.getNumber(node)._integer;
+                return true;
+            case LanguageToken::NumberToken:
+            case LanguageToken::NumberDoubleToken:
+                value = _trees.getNumber(node)._double;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Same arithmetic as Interpreter::evaluateValue. False if the interpreter has to do it
+    bool foldOperation(LanguageToken token, double lhs, double rhs, double& value){
+        switch(token){
+            case LanguageToken::AdditionToken:          value = lhs + rhs; break;
+            case LanguageToken::SubtractionToken:       value = lhs - rhs; break;
+            case LanguageToken::MultiplicationToken:    value = lhs * rhs; break;
+            default:
+                if(rhs == 0.0){
+                    return false;
+                }
+                value = lhs / rhs;
+                break;
+        }
+        if(!std::isfinite(value)){
+            return false;
+        }
+        ++_foldedCount;
+        return true;
+    }
+
+    // The operand that is left by an identity. NullNode if there is none
+    NodeIndex simplify(LanguageToken token, NodeIndex left, NodeIndex right, bool isLhsConstant, double lhs, bool isRhsConstant, double rhs) const{
+        NodeIndex operand = CompactTree::NullNode;
+        switch(token){
+            case LanguageToken::MultiplicationToken:
+                operand = isRhsConstant && rhs == 1.0 ? left : isLhsConstant && lhs == 1.0 ? right : CompactTree::NullNode;
+                break;
+            case LanguageToken::DivisionToken:
+                operand = isRhsConstant && rhs == 1.0 ? left : CompactTree::NullNode;
+                break;
+            case LanguageToken::SubtractionToken:
+                operand = isRhsConstant && rhs == 0.0 && !std::signbit(rhs) ? left : CompactTree::NullNode;
+                break;
+            default:
+                break;
+        }
+
+        // A string in an operation is an error at runtime. It has to stay in the operation to be reported
+        if(_trees.getToken(operand) == LanguageToken::StringToken){
+            return CompactTree::NullNode;
+        }
+        return operand;
+    }
+
+    // "output" prints a variable by its type and a string as text. Anything else is printed as a double
+    bool isPrintedDifferently(NodeIndex node) const{
+        LanguageToken token = _trees.getToken(node);
+        return token == LanguageToken::IdentifierToken || token == LanguageToken::StringToken || token == LanguageToken::LiteralToken;
+    }
+
+    // The operation as it was, with its operands folded. Undoes the identity that replaced it
+    NodeIndex keepOperation(NodeIndex node){
+        --_identityCount;
+        NodeIndex left = replacementOf(_trees.getLeft(node));
+        NodeIndex right = replacementOf(_trees.getRight(node));
+        if(left == _trees.getLeft(node) && right == _trees.getRight(node)){
+            return node;
+        }
+        return _trees.copyNode(node, left, right);
+    }
+
+    NodeIndex stripQuotes(NodeIndex node){
+        std::string_view value = _trees.getValue(node);
+        ++_stringCount;
+        return _trees.addNode(LanguageToken::LiteralToken, CompactTree::NullNode, CompactTree::NullNode, value.substr(1, value.size() - 2), {0}, _trees.getColumn(node));
+    }
+};
+
+#endif // CONSTANTFOLDER_H
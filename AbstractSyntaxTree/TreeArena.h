@@ -0,0 +1,81 @@
+#ifndef TREEARENA_H
+#define TREEARENA_H
+
+// Standard Libraries
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * Tree Arena
+ * - Owns the text of the spellings of a CompactTree, so the tree doesn't depend on the source it was parsed from.
+ * - Strings are bumped out of big blocks, so copying one is a memcpy and never frees anything.
+ * - Everything goes away at once with release(). Strings are never freed one by one.
+**/
+class TreeArena{
+
+private:
+    static constexpr std::size_t BlockSize = 64 * 1024;                     // Size of a block. Bigger requests get a block of their own
+
+private:
+    std::vector<std::unique_ptr<char[]>>    _blocks;                        // Every block that was allocated
+    char*                                   _cursor         = nullptr;      // Next free byte of the current block
+    char*                                   _limit          = nullptr;      // End of the current block
+    std::size_t                             _reserved       = 0;            // Bytes in all the blocks
+
+// Constructors
+public:
+    TreeArena(){}
+    ~TreeArena(){}
+
+    // The strings point into the blocks, so the arena can't be copied
+    TreeArena(TreeArena const&) = delete;
+    void operator=(TreeArena const&) = delete;
+
+// Methods
+public:
+    std::string_view copyString(std::string_view value){
+        if(value.empty()){
+            return std::string_view();
+        }
+        char* memory = (char*)allocate(value.size(), 1);
+        std::memcpy(memory, value.data(), value.size());
+        return std::string_view(memory, value.size());
+    }
+
+    // Frees every string at once. Every pointer into the arena is invalid after this
+    void release(){
+        _blocks.clear();
+        _cursor = nullptr;
+        _limit = nullptr;
+        _reserved = 0;
+    }
+
+    std::size_t getReservedBytes() const{
+        return _reserved;
+    }
+
+private:
+    void* allocate(std::size_t size, std::size_t alignment){
+        std::uintptr_t aligned = ((std::uintptr_t)_cursor + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+        if(_cursor == nullptr || aligned + size > (std::uintptr_t)_limit){
+            newBlock(size + alignment);
+            aligned = ((std::uintptr_t)_cursor + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+        }
+        _cursor = (char*)(aligned + size);
+        return (void*)aligned;
+    }
+
+    void newBlock(std::size_t minimum){
+        std::size_t size = minimum > BlockSize ? minimum : BlockSize;
+        _blocks.emplace_back(new char[size]);
+        _cursor = _blocks.back().get();
+        _limit = _cursor + size;
+        _reserved += size;
+    }
+};
+
+#endif // TREEARENA_H
@@ -0,0 +1,270 @@
+#ifndef TYPECHECKER_H
+#define TYPECHECKER_H
+
+// Standard Libraries
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Created Classes
+#include "../LanguageDictionary/LanguageDictionary.h"
+#include "../ErrorHandler/errorHandler.h"
+#include "CompactTree.h"
+
+/**
+ * Type Checker
+ * - Gives every node its static type (see CompactTree::ValueType), so the interpreter knows what to evaluate it as without looking
+ *   at the variables. Runs once the trees are validated, and again on the nodes the optimizers added.
+ * - A variable has the type of its first declaration. Declarations can't be under an if, and declaring a variable again stops the script,
+ *   so it never holds anything else. A variable that is never declared is Unknown, reading it stops the script.
+ *   A declaration in a while body is gone at the end of every iteration, so that variable could be declared again. With another type
+ *   that's a type error.
+ * - Numbers: integer literals and integer variables are Integer. "+", "-" and "*" of two Integers are Integer, "/" is always Double,
+ *   like the interpreter always did. A missing operand counts as the integer 0.
+ * - Type errors, reported before anything runs: a string in a mathematical expression, a string compared with a number,
+ *   and a string assigned to a number variable or the other way around. Every node above the error is Invalid,
+ *   so an error is only reported once, where it starts.
+ * - Nodes come before their parent, so they are typed in index order without walking the trees.
+**/
+class TypeChecker{
+
+private:
+    using LanguageToken = LanguageDictionary::LanguageToken;
+    using NodeIndex = CompactTree::NodeIndex;
+    using ValueType = CompactTree::ValueType;
+
+private:
+    CompactTree&            _trees;                                         // The trees that are typed
+    ErrorHandler*           _errorHandler       = &ErrorHandler::getInstance();
+    std::vector<ValueType>  _slotTypes;                                     // Type of every variable, by slot
+    std::vector<char>       _isScopedSlot;                                  // If the variable is declared in a while body, by slot
+    std::vector<std::pair<NodeIndex, int>> _pendingNodes;                   // Nodes left to visit by report(), with their line
+
+// Constructors
+public:
+    TypeChecker(CompactTree& trees) : _trees(trees){}
+
+    TypeChecker(TypeChecker const&) = delete;
+    void operator=(TypeChecker const&) = delete;
+
+// Methods
+public:
+
+    /**
+     * Types the nodes from `first` on. The ones before keep their type.
+     * - The errors of every statement with an Invalid root are reported, except for the statements in `skipped`
+     *   (in statement order), whose trees are already known to be broken.
+    **/
+    void run(NodeIndex first = 1, const std::vector<std::size_t>& skipped = {}){
+        findSlotTypes();
+        typeNodes(first);
+
+        std::size_t next = 0;
+        for(std::size_t i = 0; i < _trees.getStatementCount(); ++i){
+            if(next < skipped.size() && skipped[next] == i){
+                ++next;
+                continue;
+            }
+            NodeIndex root = _trees.getRoot(i);
+            if(root >= first){
+                reportTree(root, _trees.getLine(i));
+            }
+        }
+        std::vector<ValueType>().swap(_slotTypes);
+        std::vector<char>().swap(_isScopedSlot);
+    }
+
+/**
+ * Statement at a time. Used by the watch mode, which keeps a TypeChecker for as long as it runs
+ * - findSlotTypes() takes the variable types from the statements. They are kept until the next call.
+ * - typeNodes() can then type the trees of an edit with them, as long as the edit changed no declaration.
+**/
+public:
+    void findSlotTypes(){
+        _slotTypes.assign(_trees.getSlotCount(), ValueType::Unknown);
+        _isScopedSlot.assign(_trees.getSlotCount(), 0);
+        for(std::size_t i = 0; i < _trees.getStatementCount(); ++i){
+            findDeclaration(_trees.getRoot(i), false);
+        }
+    }
+
+    // Types the nodes from `first` on. A variable that is new since findSlotTypes() isn't declared anywhere, so it is Unknown
+    void typeNodes(NodeIndex first){
+        _slotTypes.resize(_trees.getSlotCount(), ValueType::Unknown);
+        _isScopedSlot.resize(_trees.getSlotCount(), 0);
+        for(std::size_t node = first; node <= _trees.getNodeCount(); ++node){
+            _trees.setType((NodeIndex)node, typeOf((NodeIndex)node));
+        }
+    }
+
+    // The errors of a typed tree, if it has any
+    void reportTree(NodeIndex root, int line){
+        if(_trees.getType(root) == ValueType::Invalid){
+            report(root, line);
+        }
+    }
+
+private:
+    // The declarations in source order. A while body is walked statement by statement
+    void findDeclaration(NodeIndex statement, bool isScoped){
+        if(_trees.getToken(statement) == LanguageToken::WhileToken){
+            for(NodeIndex block = _trees.getRight(statement); block != CompactTree::NullNode; block = _trees.getRight(block)){
+                findDeclaration(_trees.getLeft(block), true);
+            }
+            return;
+        }
+        ValueType type = declaredType(_trees.getToken(statement));
+        if(type == ValueType::Unknown){
+            return;
+        }
+        NodeIndex identifier = _trees.getLeft(_trees.getLeft(statement));
+        if(_trees.getToken(identifier) != LanguageToken::IdentifierToken){
+            return;
+        }
+        ValueType& slotType = _slotTypes[_trees.getSlot(identifier)];
+        if(slotType == ValueType::Unknown){
+            slotType = type;
+        }
+        _isScopedSlot[_trees.getSlot(identifier)] |= isScoped;
+    }
+
+    static ValueType declaredType(LanguageToken token){
+        switch(token){
+            case LanguageToken::TypeIntegerToken:   return ValueType::Integer;
+            case LanguageToken::TypeDoubleToken:    return ValueType::Double;
+            case LanguageToken::TypeStringToken:    return ValueType::String;
+            default:                                return ValueType::Unknown;
+        }
+    }
+
+    // The children are already typed
+    ValueType typeOf(NodeIndex node) const{
+        ValueType lhs = typeOfChild(_trees.getLeft(node));
+        ValueType rhs = typeOfChild(_trees.getRight(node));
+        LanguageToken token = _trees.getToken(node);
+        switch(token){
+            case LanguageToken::NumberIntegerToken:
+                return ValueType::Integer;
+            case LanguageToken::NumberToken:
+            case LanguageToken::NumberDoubleToken:
+                return ValueType::Double;
+            case LanguageToken::StringToken:
+            case LanguageToken::LiteralToken:
+                return ValueType::String;
+            case LanguageToken::IdentifierToken:
+                return _slotTypes[_trees.getSlot(node)];
+            case LanguageToken::AdditionToken:
+            case LanguageToken::SubtractionToken:
+            case LanguageToken::MultiplicationToken:
+            case LanguageToken::DivisionToken:
+                if(lhs == ValueType::Invalid || rhs == ValueType::Invalid || lhs == ValueType::String || rhs == ValueType::String){
+                    return ValueType::Invalid;
+                }
+                if(lhs == ValueType::Unknown || rhs == ValueType::Unknown){
+                    return ValueType::Unknown;
+                }
+                if(token != LanguageToken::DivisionToken && lhs == ValueType::Integer && rhs == ValueType::Integer){
+                    return ValueType::Integer;
+                }
+                return ValueType::Double;
+            case LanguageToken::LessThanToken:
+            case LanguageToken::GreaterThanToken:
+            case LanguageToken::EqualityToken:
+            case LanguageToken::NotEqualToken:
+            case LanguageToken::AssignmentToken:
+                if(lhs == ValueType::Invalid || rhs == ValueType::Invalid || !isCompatible(lhs, rhs)){
+                    return ValueType::Invalid;
+                }
+                return ValueType::None;
+            case LanguageToken::TypeIntegerToken:
+            case LanguageToken::TypeDoubleToken:
+            case LanguageToken::TypeStringToken:
+                if(isRedeclared(node)){
+                    return ValueType::Invalid;
+                }
+                return ValueType::None;
+            default:
+                if(lhs == ValueType::Invalid || rhs == ValueType::Invalid){
+                    return ValueType::Invalid;
+                }
+                return ValueType::None;
+        }
+    }
+
+    // A declaration of a variable that is declared in a while body, with another type than its first declaration
+    bool isRedeclared(NodeIndex declaration) const{
+        NodeIndex identifier = _trees.getLeft(_trees.getLeft(declaration));
+        if(_trees.getToken(identifier) != LanguageToken::IdentifierToken){
+            return false;
+        }
+        uint32_t slot = _trees.getSlot(identifier);
+        return _isScopedSlot[slot] && _slotTypes[slot] != declaredType(_trees.getToken(declaration));
+    }
+
+    // A missing operand counts as the integer 0
+    ValueType typeOfChild(NodeIndex node) const{
+        return node == CompactTree::NullNode ? ValueType::Integer : _trees.getType(node);
+    }
+
+    // A string only goes with a string. What is Unknown is left to the interpreter
+    static bool isCompatible(ValueType lhs, ValueType rhs){
+        if(lhs == ValueType::Unknown || rhs == ValueType::Unknown){
+            return true;
+        }
+        return (lhs == ValueType::String) == (rhs == ValueType::String);
+    }
+
+    // Every Invalid node whose children aren't. Walked with a stack, expressions can be deeper than the call stack.
+    // The statements of a while body are reported on their own line
+    void report(NodeIndex root, int line){
+        _pendingNodes.clear();
+        _pendingNodes.push_back({root, line});
+        while(!_pendingNodes.empty()){
+            auto [node, nodeLine] = _pendingNodes.back();
+            _pendingNodes.pop_back();
+            NodeIndex left = _trees.getLeft(node);
+            NodeIndex right = _trees.getRight(node);
+            bool isLeftInvalid = left != CompactTree::NullNode && _trees.getType(left) == ValueType::Invalid;
+            bool isRightInvalid = right != CompactTree::NullNode && _trees.getType(right) == ValueType::Invalid;
+            if(!isLeftInvalid && !isRightInvalid){
+                _errorHandler->addError(messageOf(node), nodeLine, _trees.getColumn(node));
+                continue;
+            }
+            if(isRightInvalid){
+                _pendingNodes.push_back({right, nodeLine});
+            }
+            if(isLeftInvalid){
+                int leftLine = _trees.getToken(node) == LanguageToken::OpenBraceToken ? _trees.getBodyLine(left, nodeLine) : nodeLine;
+                _pendingNodes.push_back({left, leftLine});
+            }
+        }
+    }
+
+    std::string messageOf(NodeIndex node) const{
+        std::string value(_trees.getValue(node));
+        switch(_trees.getToken(node)){
+            case LanguageToken::AssignmentToken:
+                {
+                    std::string name(_trees.getValue(_trees.getLeft(node)));
+                    if(_trees.getType(_trees.getLeft(node)) == ValueType::String){
+                        return "Cannot assign a number to the string [" + name + "] ";
+                    }
+                    return "Cannot assign a string to the number [" + name + "] ";
+                }
+            case LanguageToken::LessThanToken:
+            case LanguageToken::GreaterThanToken:
+            case LanguageToken::EqualityToken:
+            case LanguageToken::NotEqualToken:
+                return "Cannot compare a string with a number [" + value + "] ";
+            case LanguageToken::TypeIntegerToken:
+            case LanguageToken::TypeDoubleToken:
+            case LanguageToken::TypeStringToken:
+                return "Variable [" + std::string(_trees.getValue(_trees.getLeft(_trees.getLeft(node)))) + "] is already declared as another type ";
+            default:
+                return "Cannot use a string in a mathematical expression [" + value + "] ";
+        }
+    }
+};
+
+#endif // TYPECHECKER_H
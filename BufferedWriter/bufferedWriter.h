@@ -0,0 +1,189 @@
+#ifndef BUFFEREDWRITER_H
+#define BUFFEREDWRITER_H
+
+// Standard Libraries
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#else
+    #include <io.h>
+#endif
+
+/**
+ * Buffered Writer
+ * - Writes a file through one large buffer. The buffer only goes to the file when it's full or when the writer is flushed/closed.
+ * - Used for the side files (NOSPACES.txt and RES_SYM.txt) which are written a few bytes at a time, and for the output of the
+ *   script (see StandardOutput), which is written on a descriptor that is already open.
+ * - POSIX uses write(2) directly. Other platforms go through a FILE* with its own buffering turned off.
+**/
+class BufferedWriter{
+
+private:
+    static constexpr std::size_t DefaultCapacity = 1 << 20;    // 1 MiB
+
+private:
+    std::string         _filename   = "";                       // The file that is being written
+    std::vector<char>   _buffer;                                // Pending bytes
+    std::size_t         _used       = 0;                        // How much of the buffer is pending
+    bool                _isGood     = false;                    // If the file was opened and every write succeeded
+    bool                _isOwned    = true;                     // If the writer opened the file, and so closes it
+#ifndef _WIN32
+    int                 _fd         = -1;                       // Output file descriptor
+#else
+    std::FILE*          _file       = nullptr;                  // Output file
+#endif
+
+// Constructors
+public:
+    BufferedWriter(std::string filename, std::size_t capacity = DefaultCapacity){
+        this->_filename = filename;
+        this->_buffer.resize(capacity > 0 ? capacity : DefaultCapacity);
+#ifndef _WIN32
+        this->_fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        this->_isGood = _fd >= 0;
+#else
+        this->_file = std::fopen(filename.c_str(), "wb");
+        if(_file != nullptr){
+            std::setvbuf(_file, nullptr, _IONBF, 0);
+        }
+        this->_isGood = _file != nullptr;
+#endif
+        if(!_isGood){
+            std::cout << "[!] Failed to open the file [" << _filename << "]" << std::endl;
+        }
+    }
+
+    // Writes on a descriptor that is already open (1 for stdout). It's left open
+    BufferedWriter(int descriptor, std::string name, std::size_t capacity){
+        this->_filename = name;
+        this->_buffer.resize(capacity > 0 ? capacity : DefaultCapacity);
+#ifndef _WIN32
+        this->_fd = descriptor;
+        this->_isOwned = false;
+        this->_isGood = _fd >= 0;
+#else
+        // A FILE* of its own, so closing it doesn't close the descriptor
+        int duplicate = _dup(descriptor);
+        this->_file = duplicate >= 0 ? _fdopen(duplicate, "wb") : nullptr;
+        if(_file != nullptr){
+            std::setvbuf(_file, nullptr, _IONBF, 0);
+        }
+        this->_isGood = _file != nullptr;
+#endif
+    }
+
+    ~BufferedWriter(){
+        close();
+    }
+
+    // The descriptor is owned by the writer, so it can't be copied
+    BufferedWriter(BufferedWriter const&) = delete;
+    void operator=(BufferedWriter const&) = delete;
+
+// Methods
+public:
+    void write(const char* data, std::size_t size){
+        if(!_isGood){
+            return;
+        }
+
+        // Doesn't fit anymore. Empty the buffer first
+        if(size > _buffer.size() - _used){
+            flush();
+        }
+
+        // Bigger than the whole buffer. No point in copying it
+        if(size >= _buffer.size()){
+            writeThrough(data, size);
+            return;
+        }
+        std::memcpy(_buffer.data() + _used, data, size);
+        _used += size;
+    }
+
+    void write(std::string_view text){
+        write(text.data(), text.size());
+    }
+
+    void write(char c){
+        if(_used == _buffer.size()){
+            flush();
+        }
+        _buffer[_used++] = c;
+    }
+
+    // Little endian, so the binary files are the same on every platform
+    void writeUInt32(uint32_t value){
+        char bytes[4] = {(char)(value & 0xFF), (char)((value >> 8) & 0xFF), (char)((value >> 16) & 0xFF), (char)((value >> 24) & 0xFF)};
+        write(bytes, sizeof(bytes));
+    }
+
+    void flush(){
+        if(_used > 0){
+            writeThrough(_buffer.data(), _used);
+            _used = 0;
+        }
+    }
+
+    void close(){
+        flush();
+#ifndef _WIN32
+        if(_fd >= 0 && _isOwned){
+            ::close(_fd);
+        }
+        _fd = -1;
+#else
+        if(_file != nullptr){
+            std::fclose(_file);
+            _file = nullptr;
+        }
+#endif
+    }
+
+    bool isGood() const{
+        return _isGood;
+    }
+
+    const std::string& getFilename() const{
+        return _filename;
+    }
+
+private:
+    void writeThrough(const char* data, std::size_t size){
+        if(!_isGood){
+            return;
+        }
+#ifndef _WIN32
+        while(size > 0){
+            ssize_t count = ::write(_fd, data, size);
+            if(count < 0 && errno == EINTR){
+                continue;
+            }
+            if(count < 0){
+                std::cout << "[!] Failed to write to the file [" << _filename << "]" << std::endl;
+                _isGood = false;
+                return;
+            }
+            data += count;
+            size -= (std::size_t)count;
+        }
+#else
+        if(std::fwrite(data, 1, size, _file) != size){
+            std::cout << "[!] Failed to write to the file [" << _filename << "]" << std::endl;
+            _isGood = false;
+        }
+#endif
+    }
+};
+
+#endif // BUFFEREDWRITER_H
@@ -4,9 +4,18 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "../LanguageDictionary/LanguageDictionary.h"
 
+// An error that was captured instead of logged. Lines are kept as numbers so they can be moved later
+struct Diagnostic{
+    std::string     _message;                                           // The error without the position
+    int             _line           = 0;                                // Line of the error
+    int             _column         = 0;                                // Column of the error
+    bool            _hasPosition    = false;                            // If the error was reported with a line and column
+};
+
 /*
  * This class will be used to log errors to a file and to the console.
  */
@@ -20,6 +29,7 @@ private:
     bool            _hasError               = false;                // If there is an error
     bool            _hasAlreadyDisplayed    = false;                // If the error has already been displayed
     int             _errorCount             = 0;                    // The number of errors
+    std::vector<Diagnostic>* _capture       = nullptr;              // If set, errors go here instead of the log
 
 private:
     ErrorHandler(){
@@ -77,20 +87,52 @@ public:
     }
 
     void addError(std::string error){
+        if(_capture != nullptr){
+            _capture->push_back({error, 0, 0, false});
+            return;
+        }
         _errorCount++;
         _hasError = true;
         _errorString += "[ERROR] " + error + "\n";
     }
 
     void addError(std::string error, int line, int column){
+        if(_capture != nullptr){
+            _capture->push_back({error, line, column, true});
+            return;
+        }
         _errorCount++;
         _hasError = true;
         _errorString += "[ERROR] " + error +  "at line: " + std::to_string(line) + " column: " + std::to_string(column) + "\n"; 
     }
 
+    // Logs a captured error, moved down by lineOffset lines
+    void addError(const Diagnostic& diagnostic, int lineOffset = 0){
+        if(diagnostic._hasPosition){
+            addError(diagnostic._message, diagnostic._line + lineOffset, diagnostic._column);
+        }else{
+            addError(diagnostic._message);
+        }
+    }
+
     int getErrorCount(){
         return _errorCount;
     }
+
+    // Until stopped with nullptr, errors are appended to `capture` instead of being logged. Used to keep the errors per statement
+    void captureErrors(std::vector<Diagnostic>* capture){
+        _capture = capture;
+    }
+
+    // Forget every error and start a new log. Used when the same file is checked again
+    void clear(){
+        _errorString = "";
+        _hasError = false;
+        _hasAlreadyDisplayed = false;
+        _errorCount = 0;
+        _errorLog.close();
+        _errorLog.open(_errorLogPath);
+    }
 };
 
 #endif // ERRORHANDLER_H
@@ -1,23 +1,39 @@
 #ifndef HLINT_H
 #define HLINT_H
 
+#include "Options/options.h"
 #include "LexicalAnalyzer/lexicalAnalyzer.h"
+#include "Watcher/watcher.h"
 
 class HLint{
 private:
-    LexicalAnalyzer* lexicalAnalyzer;
+    LexicalAnalyzer* lexicalAnalyzer = nullptr;
+    Watcher* watcher = nullptr;
 
 public:
     HLint(std::string filename = "test.txt"){
         lexicalAnalyzer = new LexicalAnalyzer(filename);
     }
 
+    HLint(const Options& options){
+        if(options._watch){
+            watcher = new Watcher(options._filename);
+        }else{
+            lexicalAnalyzer = new LexicalAnalyzer(options);
+        }
+    }
+
     ~HLint(){
         delete lexicalAnalyzer;
+        delete watcher;
     }
 
 public:
     void start(){
+        if(watcher != nullptr){
+            watcher->run();
+            return;
+        }
         lexicalAnalyzer->analyze();
     }
 };
@@ -4,11 +4,25 @@
 #include "../AbstractSyntaxTree/AbstractSyntaxTree.h"
 #include "../LanguageDictionary/LanguageDictionary.h"
 #include "../SymbolTable/symbolTable.h"
+#include "../StandardOutput/standardOutput.h"
+#include "../StandardInput/standardInput.h"
+#include "../NumberText/numberText.h"
+#include "number.h"
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
 #include <string>
+#include <utility>
+#include <vector>
 
 class Interpreter{
 private:
     using LanguageToken = LanguageDictionary::LanguageToken;
+    using NodeIndex = CompactTree::NodeIndex;
+    using ValueType = CompactTree::ValueType;
+
+    static constexpr std::size_t MaxRecursionDepth = 256;                                  // Deeper expressions are evaluated with a stack
+
 private:
     Interpreter(){}
     ~Interpreter(){}
@@ -22,28 +36,36 @@ public:
 private:
     SymbolTable*            _symbolTable            = &SymbolTable::getInstance();          // The symbol table
     LanguageDictionary*     _languageDictionary     = &LanguageDictionary::getInstance();   // The language dictionary
+    StandardOutput*         _output                 = &StandardOutput::getInstance();       // Where the script prints
+    StandardInput*          _input                  = &StandardInput::getInstance();        // Where the script reads from
+    const CompactTree*      _trees                  = nullptr;                              // The trees of the script. Only read, never changed
+    std::vector<std::pair<NodeIndex, bool>> _pendingNodes;                                  // Walk of evaluate(). The bool is set once the operands are pushed
+    std::vector<Number>     _operands;                                                      // Values evaluate() computed and didn't use yet
+    std::vector<SymbolTable::Slot> _declaredSlots;                                          // What the bodies of the running whiles declare, innermost last
     
     // Temporary Support for One Way If
     // Will be removed after the implementation of scopes
     bool _inIfScope = false;
 
 public:
-    void interpret(AuxillaryTree* &tree, bool isInterpretAll = false){
+    // Runs a single statement of the script
+    void interpret(const CompactTree& trees, NodeIndex tree){
+        _trees = &trees;
+        _symbolTable->resize(trees.getSlotCount());
+        _declaredSlots.clear();
+        interpret(tree);
+    }
+
+private:
+    void interpret(NodeIndex tree){
 
         // If the tree is nullptr, then return
-        if(tree == nullptr){
+        if(tree == CompactTree::NullNode){
             return;
         }
 
-        // If we want to interpret all subtrees, then we will interpret the left and right subtree
-        if(isInterpretAll){
-            interpret(tree->_left, true);
-            interpret(tree->_right, true);
-        }
-
-        // Otherwise, we will interpret the current subtree
         bool isCorrect = false;                                                             // Signifies if the tree is correct
-        switch(tree->_token){
+        switch(_trees->getToken(tree)){
             case LanguageToken::CharacterToken:
             case LanguageToken::IdentifierToken:
             case LanguageToken::NumberToken:
@@ -60,11 +82,7 @@ public:
             case LanguageToken::SubtractionToken:
             case LanguageToken::MultiplicationToken:
             case LanguageToken::DivisionToken:
-                {
-                    std::string value = getTreeValues(tree);
-                    deleteReplaceTree(tree, LanguageToken::NumberToken, value);
-                    evaluateMathematicalExpression(tree);
-                }
+                // Evaluated by evaluate() when the value is used. The tree stays as it is
                 break;
             case LanguageToken::AssignmentToken:
                 handleAssignment(tree);
@@ -84,295 +102,392 @@ public:
             case LanguageToken::IfToken:
                 handleIfCondition(tree);
                 break;
+            case LanguageToken::WhileToken:
+                handleWhile(tree);
+                break;
             case LanguageToken::TypeIntegerToken:
             case LanguageToken::TypeDoubleToken:
             case LanguageToken::TypeStringToken:
                 handleDeclaration(tree);
                 break;
             default:
-                throw std::runtime_error("Token: " + tree->_value + ". Either the token is not implemented or there's a problem with the AST");
+                throw std::runtime_error("Token: " + std::string(_trees->getValue(tree)) + ". Either the token is not implemented or there's a problem with the AST");
                 break;
         }
     }
 
+    /**
+     * Every statement in the tree, children first, the way the statement of an if always ran. Only an if has a statement under it,
+     * so "if (a) if (b) S" runs S, then the inner if, which runs S again if b holds. Expressions aren't walked.
+    **/
+    void interpretAll(NodeIndex tree){
+        if(_trees->getToken(tree) == LanguageToken::IfToken){
+            interpretAll(_trees->getRight(tree));
+        }
+        interpret(tree);
+    }
+
 // This assume that the tree is already evaluated and conforms to the language
 private:
-    void handleIfCondition(AuxillaryTree* tree){
+    void handleIfCondition(NodeIndex tree){
         // LHS will always be a condition
         // RHS will always be a statement
         
-        AuxillaryTree* lhs = tree->_left;
-        AuxillaryTree* rhs = tree->_right;
+        NodeIndex lhs = _trees->getLeft(tree);
+        NodeIndex rhs = _trees->getRight(tree);
 
         _inIfScope = true;
 
         bool isTrue = handleCondition(lhs);
 
         if(isTrue){
-            interpret(rhs, true);
+            interpretAll(rhs);
         }else{
         }
         _inIfScope = false;
     }
 
-    bool handleCondition(AuxillaryTree* tree){
+    // The body is a chain of '{' nodes with a statement on the left of each. Runs as long as the condition holds.
+    // A variable the body declares is removed at the end of every iteration. Their slots are found on the first iteration and kept
+    // on _declaredSlots, above those of the whiles this one runs in, so a loop doesn't allocate or look for them again
+    void handleWhile(NodeIndex tree){
+        NodeIndex condition = _trees->getLeft(tree);
+        NodeIndex body = _trees->getRight(tree);
+        std::size_t first = _declaredSlots.size();
+        bool isFirstIteration = true;
+
+        while(handleCondition(condition)){
+            for(NodeIndex block = body; block != CompactTree::NullNode; block = _trees->getRight(block)){
+                NodeIndex statement = _trees->getLeft(block);
+                interpret(statement);
+                if(isFirstIteration && isDeclaration(_trees->getToken(statement))){
+                    _declaredSlots.push_back(_trees->getSlot(_trees->getLeft(_trees->getLeft(statement))));
+                }
+            }
+            isFirstIteration = false;
+            for(std::size_t i = first; i < _declaredSlots.size(); ++i){
+                _symbolTable->remove(_declaredSlots[i]);
+            }
+        }
+        _declaredSlots.resize(first);
+    }
+
+    static bool isDeclaration(LanguageToken token){
+        return token == LanguageToken::TypeIntegerToken || token == LanguageToken::TypeDoubleToken || token == LanguageToken::TypeStringToken;
+    }
+
+    bool handleCondition(NodeIndex tree){
         // LHS will always be a mathematical expression
         // RHS will always be a mathematical expression
         // Tree Token will always be a condition token
 
-        AuxillaryTree* lhs = tree->_left;
-        AuxillaryTree* rhs = tree->_right;
+        NodeIndex lhs = _trees->getLeft(tree);
+        NodeIndex rhs = _trees->getRight(tree);
+        ValueType lhsType = typeOf(lhs);
+        ValueType rhsType = typeOf(rhs);
 
-        
-        if(lhs->_token == LanguageToken::StringToken){
-            if(rhs->_token != LanguageToken::StringToken){
+        if(lhsType == ValueType::String || rhsType == ValueType::String){
+            // Only with a variable that is never declared. TypeChecker reports the rest
+            if(lhsType != rhsType){
                 throw std::runtime_error("Cannot compare string with non-string");
             }
-
-            return evaluateComparison<std::string>(tree->_token, lhs->_value, rhs->_value);
+            return evaluateComparison<std::string>(_trees->getToken(tree), stringOf(lhs), stringOf(rhs));
         }
 
-        // Then it's an error
-        if(rhs->_token == LanguageToken::StringToken){
-            throw std::runtime_error("Cannot compare string with non-string");
+        Number lhsValue = evaluate(lhs);
+        Number rhsValue = evaluate(rhs);
+        if(lhsValue._isInteger && rhsValue._isInteger){
+            return evaluateComparison<int64_t>(_trees->getToken(tree), lhsValue._integer, rhsValue._integer);
         }
-        
-        // Interpret LHS and RHS to get the smallest unit of value
-        interpret(lhs, true);
-        interpret(rhs, true);
-        double lhsValue = evaluateMathematicalExpression(lhs);
-        double rhsValue = evaluateMathematicalExpression(rhs);
-        return evaluateComparison<double>(tree->_token, lhsValue, rhsValue);
+        return evaluateComparison<double>(_trees->getToken(tree), lhsValue.toDouble(), rhsValue.toDouble());
     }
-    void handleOutput(AuxillaryTree* tree){
+    void handleOutput(NodeIndex tree){
         // Tree Token will always be <<
         // LHS wll always be the output keyword
         // RHS will always be a printable value
         
-        AuxillaryTree* rhs = tree->_right;
-        if(rhs->_token == LanguageToken::StringToken){
-            std::string value = rhs->_value;
-            // Remove the quotes
-            value = value.substr(1, value.size() - 2);
-            std::cout << value << std::endl;
-        }else{
-            interpret(rhs, true);
-            if(rhs->_token == LanguageToken::IdentifierToken){
-                std::string value = rhs->_value;
-                auto variable = _symbolTable->get(value);
-                if(variable->getType() == "integer"){
-                    ObjectTypeInt* variableInt = _symbolTable->parseToInt(variable);
-                    std::cout << variableInt->getValue() << std::endl;
-                }else if(variable->getType() == "double"){
-                    ObjectTypeDouble* variableDouble = _symbolTable->parseToDouble(variable);
-                    std::cout << variableDouble->getValue() << std::endl;
-                }else if(variable->getType() == "string"){
-                    ObjectTypeString* variableString = _symbolTable->parseToString(variable);
-                    std::cout << variableString->getValue() << std::endl;
+        NodeIndex rhs = _trees->getRight(tree);
+        switch(_trees->getToken(rhs)){
+            case LanguageToken::LiteralToken:
+                // A string the optimizer already took the quotes off
+                _output->writeLine(_trees->getValue(rhs));
+                return;
+            case LanguageToken::StringToken:
+                _output->writeLine(stringOf(rhs));
+                return;
+            case LanguageToken::IdentifierToken:
+                {
+                    // Printed by the type of the variable
+                    SymbolTable::Slot slot = _trees->getSlot(rhs);
+                    switch(typeOf(rhs)){
+                        case ValueType::Integer:
+                            _output->writeInteger(_symbolTable->getInteger(slot));
+                            break;
+                        case ValueType::Double:
+                            _output->writeDouble(_symbolTable->getDouble(slot));
+                            break;
+                        case ValueType::String:
+                            _output->writeLine(_symbolTable->getString(slot));
+                            break;
+                        default:
+                            _symbolTable->get(slot);                                        // Never declared. Throws
+                            break;
+                    }
                 }
                 return;
-            }
-            std::string value = rhs->_value;
-            double realValue = std::stod(value);
-            std::cout << realValue << std::endl;
+            default:
+                break;
         }
+
+        // Every other expression is printed as a double
+        double realValue = evaluate(rhs).toDouble();
+        _output->writeDouble(realValue);
     }
-    void handleInput(AuxillaryTree* &tree){
+    void handleInput(NodeIndex tree){
         // Tree token will always be >> operator
         // LHS will always be the input keyword
         // RHS will always be an identifier
-        AuxillaryTree* rhs = tree->_right;
-        std::string value;
-        std::getline(std::cin, value);
-        std::string identifier = rhs->_value;
-        auto variable = _symbolTable->get(identifier);
-        if(variable->getType() == "integer"){
-            ObjectTypeInt* variableInt = _symbolTable->parseToInt(variable);
-            try{
-                variableInt->setValue(std::stoi(value));
-            }catch(std::invalid_argument& e){
-                throw std::runtime_error("Cannot convert input to integer");
-            }
-        }else if(variable->getType() == "double"){
-            ObjectTypeDouble* variableDouble = _symbolTable->parseToDouble(variable);
-            try{
-                variableDouble->setValue(std::stod(value));
-            }catch(std::invalid_argument& e){
-                throw std::runtime_error("Cannot convert input to double");
-            }
-        }else if(variable->getType() == "string"){
-            ObjectTypeString* variableString = _symbolTable->parseToString(variable);
-            variableString->setValue(value);
+        NodeIndex rhs = _trees->getRight(tree);
+        _output->beforeInput();
+        std::string_view value = _input->readLine();
+        SymbolTable::Slot slot = _trees->getSlot(rhs);
+        switch(typeOf(rhs)){
+            case ValueType::Integer:
+                {
+                    Value& variable = _symbolTable->get(slot);                              // Checked before the conversion
+                    int integer;
+                    switch(NumberText::readInteger(value, integer)){
+                        case NumberText::Parsed:        variable._integer = integer;                                    break;
+                        case NumberText::Invalid:       throw std::runtime_error("Cannot convert input to integer");
+                        case NumberText::OutOfRange:    throw std::out_of_range("stoi");
+                    }
+                }
+                break;
+            case ValueType::Double:
+                {
+                    Value& variable = _symbolTable->get(slot);                              // Checked before the conversion
+                    switch(NumberText::readDouble(value, variable._double)){
+                        case NumberText::Parsed:                                                                        break;
+                        case NumberText::Invalid:       throw std::runtime_error("Cannot convert input to double");
+                        case NumberText::OutOfRange:    throw std::out_of_range("stod");
+                    }
+                }
+                break;
+            case ValueType::String:
+                _symbolTable->setString(slot, value);
+                break;
+            default:
+                _symbolTable->get(slot);                                                    // Never declared. Throws
+                break;
         }
     }
 
 
-    void handleDeclaration(AuxillaryTree* &tree){
+    void handleDeclaration(NodeIndex tree){
         // Tree Token wil always be its type
         // LHS will always be a colon operator
         // RHS will always be a nulptr
         // LHS->LHS will always be an identifier
 
-        AuxillaryTree* lhs = tree->_left;
-        AuxillaryTree* lhsLhs = lhs->_left;
-        if(tree->_token == LanguageToken::TypeIntegerToken){
-            ObjectTypeInt* variable = new ObjectTypeInt(lhsLhs->_value, 0);
-            _symbolTable->declare(lhsLhs->_value, variable);
-        }else if(tree->_token == LanguageToken::TypeDoubleToken){
-            ObjectTypeDouble* variable = new ObjectTypeDouble(lhsLhs->_value, 0.0);
-            _symbolTable->declare(lhsLhs->_value, variable);
-        }else if(tree->_token == LanguageToken::TypeStringToken){
-            ObjectTypeString* variable = new ObjectTypeString(lhsLhs->_value, "");
-            _symbolTable->declare(lhsLhs->_value, variable);
+        NodeIndex lhs = _trees->getLeft(tree);
+        NodeIndex lhsLhs = _trees->getLeft(lhs);
+        SymbolTable::Slot slot = _trees->getSlot(lhsLhs);
+        if(_trees->getToken(tree) == LanguageToken::TypeIntegerToken){
+            _symbolTable->declare(slot, Value::Tag::Integer);
+        }else if(_trees->getToken(tree) == LanguageToken::TypeDoubleToken){
+            _symbolTable->declare(slot, Value::Tag::Double);
+        }else if(_trees->getToken(tree) == LanguageToken::TypeStringToken){
+            _symbolTable->declare(slot, Value::Tag::String);
         }
 
         if(_inIfScope){
             _inIfScope = false;
-            _symbolTable->remove(lhsLhs->_value);
+            _symbolTable->remove(slot);
         }
 
     }
 
-    void handleAssignment(AuxillaryTree* &tree){
+    void handleAssignment(NodeIndex tree){
         // Tree token is :=
         // LHS will always be an Identifier
-        // RHS will always be a mathematical expression
+        // RHS will always be an expression of the type of the LHS (see TypeChecker)
         
-        AuxillaryTree* lhs = tree->_left;
-        AuxillaryTree* rhs = tree->_right;
-        double realValue = evaluateMathematicalExpression(tree->_right);
-        auto variable = _symbolTable->get(lhs->_value);
-        if(variable->getType() == "integer"){
-            ObjectTypeInt* variableInt = _symbolTable->parseToInt(variable);
-            variableInt->setValue(realValue);
-            this->_symbolTable->set(lhs->_value, variableInt);
-        }else if(variable->getType() == "double"){
-            ObjectTypeDouble* variableDouble = _symbolTable->parseToDouble(variable);
-            variableDouble->setValue(realValue);
-            this->_symbolTable->set(lhs->_value, variableDouble);
-        }else if(variable->getType() == "string"){
-            ObjectTypeString* variableString = _symbolTable->parseToString(variable);
-            variableString->setValue(std::to_string(realValue));
-            this->_symbolTable->set(lhs->_value, variableString);
+        NodeIndex lhs = _trees->getLeft(tree);
+        NodeIndex rhs = _trees->getRight(tree);
+        SymbolTable::Slot slot = _trees->getSlot(lhs);
+
+        // The variable is changed in place, so there is nothing to write back
+        switch(typeOf(lhs)){
+            case ValueType::Integer:
+                {
+                    // A variable that isn't declared is reported before a value it can't hold
+                    Number number = evaluate(rhs);
+                    Value& variable = _symbolTable->get(slot);
+                    variable._integer = number.toInt();
+                }
+                break;
+            case ValueType::Double:
+                {
+                    double realValue = evaluate(rhs).toDouble();
+                    _symbolTable->setDouble(slot, realValue);
+                }
+                break;
+            case ValueType::String:
+                {
+                    std::string value = stringOf(rhs);
+                    _symbolTable->setString(slot, value);
+                }
+                break;
+            default:
+                evaluate(rhs);
+                _symbolTable->get(slot);                                                    // Never declared. Throws
+                break;
         }
     }
-    
-    double evaluateMathematicalExpression(AuxillaryTree* &tree){
-        // Tree token will always be a mathetical expression
-        interpret(tree, true);
-        std::string     expression      = tree->_value;         // The expression to be evaluated
-        char            c               = ' ';                  // The current character being evaluated
-        std::string     token           = "";                   // The current token being evaluated
-        double          evaluatedValue  = 0.0;                  // The value of the expression
-        bool            nextIsASign     = true;                 // Whether the next token is a sign
-        int             signModifier    = 1;                    // The sign modifier
-        bool            isString        = false;                // Whether the expression is a string
-
-        // 0 = Addition
-        // 1 = Subtraction
-        // 2 = Multiplication
-        // 3 = Division
-        int typeOfOperation = 0;
-        for(int i = 0; i < expression.length(); ++i){
-            c = expression[i];
-            token += c;
-            if(token == "\""){
-                isString = true;
-            }else if(this->isDigit(token)){
-                token = getValueUntilNot(expression, i, &Interpreter::isDigit, true);
-                evaluateValue(evaluatedValue, std::stod(token)*signModifier, typeOfOperation);
-            }
-            else if(this->isIdentifier(token)){
-                token = getValueUntilNot(expression, i, &Interpreter::isIdentifier);
-                auto variable = _symbolTable->get(token);
-                if(variable->getType() == "integer"){
-                    ObjectTypeInt* variableInt = _symbolTable->parseToInt(variable);
-                    evaluateValue(evaluatedValue, (double)variableInt->getValue()*signModifier, typeOfOperation);
-                    nextIsASign = false;
-                }else if(variable->getType() == "double"){
-                    ObjectTypeDouble* variableDouble = _symbolTable->parseToDouble(variable);
-                    evaluateValue(evaluatedValue, variableDouble->getValue()*signModifier, typeOfOperation);
-                    nextIsASign = false;
+
+    // A missing operand counts as the integer 0
+    ValueType typeOf(NodeIndex tree) const{
+        return tree == CompactTree::NullNode ? ValueType::Integer : _trees->getType(tree);
+    }
+
+    /**
+     * Value of a number expression. The tree is only read, values never go through text.
+     * - The left operand is done before the right one, so a script that stops on an error stops on the same one.
+     * - Whole numbers stay in 64 bits as long as that gives the same value as a double (see Number).
+     * - Recursive, which is the fastest for the usual expressions. What is deeper than MaxRecursionDepth is left to evaluateDeep()
+    **/
+    Number evaluate(NodeIndex tree, std::size_t depth = 0){
+        LanguageToken token = _trees->getToken(tree);
+        if(!isArithmetic(token)){
+            return operandOf(tree);
+        }
+        if(depth == MaxRecursionDepth){
+            return evaluateDeep(tree);
+        }
+        Number lhs = evaluate(_trees->getLeft(tree), depth + 1);
+        Number rhs = evaluate(_trees->getRight(tree), depth + 1);
+        return operate(token, lhs, rhs);
+    }
+
+    // Same as evaluate(), walked with a stack. Expressions can be deeper than the call stack
+    Number evaluateDeep(NodeIndex tree){
+        // Operands that aren't operations are never pushed. A left one is read when its operation is reached, a right one once the left is done
+        _pendingNodes.clear();
+        _operands.clear();
+        _pendingNodes.push_back({tree, false});
+        while(!_pendingNodes.empty()){
+            auto [node, isExpanded] = _pendingNodes.back();
+            _pendingNodes.pop_back();
+            NodeIndex left = _trees->getLeft(node);
+            NodeIndex right = _trees->getRight(node);
+            bool isRightOperation = isArithmetic(_trees->getToken(right));
+            if(!isExpanded){
+                _pendingNodes.push_back({node, true});
+                if(isRightOperation){
+                    _pendingNodes.push_back({right, false});
                 }
-            }else if(token == "+"){
-                if(nextIsASign) { signModifier = 1; }
-                else            { typeOfOperation = 0; }
-                nextIsASign = true;
-            }else if(token == "-"){
-                if(nextIsASign) { signModifier = -1; }
-                else            { typeOfOperation = 1; }
-                nextIsASign     = true;
-            }else if(token == "*"){
-                typeOfOperation = 2;
-                signModifier    = 1;
-                nextIsASign = true;
-            }else if(token == "/"){
-                typeOfOperation = 3;
-                signModifier    = 1;
-                nextIsASign     = true;
+                if(isArithmetic(_trees->getToken(left))){
+                    _pendingNodes.push_back({left, false});
+                }else{
+                    _operands.push_back(operandOf(left));
+                }
+                continue;
+            }
+            Number rhs;
+            if(isRightOperation){
+                rhs = _operands.back();
+                _operands.pop_back();
+            }else{
+                rhs = operandOf(right);
             }
-            token ="";
+            Number& lhs = _operands.back();
+            lhs = operate(_trees->getToken(node), lhs, rhs);
         }
-        tree->_value = std::to_string(evaluatedValue);
-        return evaluatedValue;
+        return _operands.back();
     }
-private:
-    bool isDigit(std::string value){
-        auto digits = _languageDictionary->getNumberAlphabet();
-        return digits.find(value[0]) != digits.end();
+
+    // A number or a variable. Literals were already converted by the lexer. Missing operands (e.g. the lhs of a sign) count as 0
+    Number operandOf(NodeIndex tree){
+        switch(_trees->getToken(tree)){
+            case LanguageToken::InvalidToken:
+                if(tree == CompactTree::NullNode){
+                    return Number::ofInteger(0);
+                }
+                break;
+            case LanguageToken::NumberIntegerToken:
+                return Number::ofLiteral(_trees->getNumber(tree)._integer);
+            case LanguageToken::NumberToken:
+            case LanguageToken::NumberDoubleToken:
+                return Number::ofDouble(_trees->getNumber(tree)._double);
+            case LanguageToken::IdentifierToken:
+                {
+                    SymbolTable::Slot slot = _trees->getSlot(tree);
+                    switch(typeOf(tree)){
+                        case ValueType::Integer:
+                            return Number::ofInteger(_symbolTable->getInteger(slot));
+                        case ValueType::Double:
+                            return Number::ofDouble(_symbolTable->getDouble(slot));
+                        default:
+                            _symbolTable->get(slot);                                        // Never declared. Throws
+                            return Number::ofInteger(0);
+                    }
+                }
+            case LanguageToken::StringToken:
+                throw std::runtime_error("Cannot use a string literal in a mathematical expression");
+            default:
+                break;
+        }
+        throw std::runtime_error("Token: " + std::string(_trees->getValue(tree)) + ". Is not a mathematical expression");
     }
-    bool isDigit(char value){
-        auto digits = _languageDictionary->getNumberAlphabet();
-        return digits.find(value) != digits.end();
+
+    static Number operate(LanguageToken token, Number lhs, Number rhs){
+        switch(token){
+            case LanguageToken::AdditionToken:          return Number::add(lhs, rhs);
+            case LanguageToken::SubtractionToken:       return Number::subtract(lhs, rhs);
+            case LanguageToken::MultiplicationToken:    return Number::multiply(lhs, rhs);
+            default:                                    return Number::divide(lhs, rhs);
+        }
     }
-    bool isIdentifier(std::string value){
-        auto alphabet = _languageDictionary->getAlphabet();
-        return alphabet.find(value[0]) !=  alphabet.end();
+
+    static bool isArithmetic(LanguageToken token){
+        return token == LanguageToken::AdditionToken || token == LanguageToken::SubtractionToken
+            || token == LanguageToken::MultiplicationToken || token == LanguageToken::DivisionToken;
     }
-    bool isIdentifier(char value){
-        auto alphabet = _languageDictionary->getAlphabet();
-        return alphabet.find(value) != alphabet.end();
+
+    // Text of a String expression: a string literal, with or without its quotes, or a string variable
+    std::string stringOf(NodeIndex tree){
+        switch(_trees->getToken(tree)){
+            case LanguageToken::StringToken:
+                {
+                    // Remove the quotes
+                    std::string_view value = _trees->getValue(tree);
+                    return std::string(value.substr(1, value.size() - 2));
+                }
+            case LanguageToken::LiteralToken:
+                return std::string(_trees->getValue(tree));
+            case LanguageToken::IdentifierToken:
+                if(typeOf(tree) == ValueType::String){
+                    return _symbolTable->getString(_trees->getSlot(tree));
+                }
+                _symbolTable->get(_trees->getSlot(tree));                                  // Never declared. Throws
+                return "";
+            default:
+                break;
+        }
+        throw std::runtime_error("Token: " + std::string(_trees->getValue(tree)) + ". Is not a string");
     }
 private:
-    LanguageToken getNumberType(AuxillaryTree* &tree){
-        if(tree->_token == LanguageToken::NumberIntegerToken){
+    LanguageToken getNumberType(NodeIndex tree){
+        if(_trees->getToken(tree) == LanguageToken::NumberIntegerToken){
             return LanguageToken::NumberIntegerToken;
-        }else if(tree->_token == LanguageToken::NumberDoubleToken){
+        }else if(_trees->getToken(tree) == LanguageToken::NumberDoubleToken){
             return LanguageToken::NumberDoubleToken;
         }
         throw std::runtime_error("Invalid Number Type");
     }
 private:
-    void deleteReplaceTree(AuxillaryTree* &tree, LanguageToken token, std::string value){
-        tree->_token = token;
-        tree->_value = value;
-        if(tree->_left != nullptr){
-            delete tree->_left;
-        }
-        if(tree->_right != nullptr){
-            delete tree->_right;
-        }
-        tree->_left = nullptr;
-        tree->_right = nullptr;
-    }
-    std::string getTreeValues(AuxillaryTree* &tree){
-        if(tree == nullptr){
-            return "";
-        }
-        return getTreeValues(tree->_left) + tree->_value + getTreeValues(tree->_right);
-    }
-    std::string getValueUntilNot(std::string &expression, int &index, bool (Interpreter::*func)(char), bool allowDecimal = false){
-        std::string token = "";
-        char c = expression[index];
-        while((this->*func)(c) || (allowDecimal && c == '.')){
-            token += c;
-            c = expression[++index];
-        }
-        --index;
-        return token;
-    }
     template<typename T>
-    bool evaluateComparison(LanguageToken &token, T lhsValue, T rhsValue){
+    bool evaluateComparison(LanguageToken token, T lhsValue, T rhsValue){
         switch(token){
             case LanguageToken::LessThanToken:
                 return lhsValue < rhsValue;
@@ -389,27 +504,6 @@ private:
         return false;
     }
     
-    template<typename T>
-    void evaluateValue(T &total, T rhsValue, int typeOfOperation){
-        switch(typeOfOperation){
-            case 0:
-                total += rhsValue;
-                break;
-            case 1:
-                total -= rhsValue;
-                break;
-            case 2:
-                total *= rhsValue;
-                break;
-            case 3:
-                total /= rhsValue;
-                break;
-            default:
-                break;
-        }
-    }
-
-    
 };
 
 #endif // INTERPRETER_H
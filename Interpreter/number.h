@@ -0,0 +1,99 @@
+#ifndef NUMBER_H
+#define NUMBER_H
+
+// Standard Libraries
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+
+/**
+ * Number
+ * - A value of a number expression, shared by the Interpreter and the VirtualMachine so both compute the same thing.
+ * - Every value the interpreter ever printed came from double arithmetic. Whole numbers stay in 64 bits as long as that gives
+ *   the same value: a step of two integers that isn't exact in a double (beyond 2^53), or that would be -0 there
+ *   (a 0 product with a negative operand), is done in double, and so is everything above it. "/" is always a double division.
+ * - An Integer is always exact, so "+" and "-" of two of them can't overflow.
+**/
+struct Number{
+    static constexpr int64_t LargestExactInteger = (int64_t)1 << 53;       // Every integer up to it is exact in a double
+
+    union{
+        int64_t _integer;
+        double  _double;
+    };
+    bool        _isInteger;
+
+    static Number ofInteger(int64_t value){
+        Number number;
+        number._integer = value;
+        number._isInteger = true;
+        return number;
+    }
+
+    static Number ofDouble(double value){
+        Number number;
+        number._double = value;
+        number._isInteger = false;
+        return number;
+    }
+
+    // An integer literal, which can be beyond 2^53
+    static Number ofLiteral(int64_t value){
+        return isExact(value) ? ofInteger(value) : ofDouble((double)value);
+    }
+
+    double toDouble() const{
+        return _isInteger ? (double)_integer : _double;
+    }
+
+    // What an integer variable holds, truncated like every value used to be. A value an int can't hold stops the script,
+    // also one that isn't finite (a division by 0). Converting it would be undefined
+    int toInt() const{
+        if(_isInteger && _integer >= INT_MIN && _integer <= INT_MAX){
+            return (int)_integer;
+        }
+        double value = toDouble();
+        if(!(value > -2147483649.0 && value < 2147483648.0)){
+            throw std::runtime_error("Value is out of the range of an integer");
+        }
+        return (int)value;
+    }
+
+    static bool isExact(int64_t value){
+        return value >= -LargestExactInteger && value <= LargestExactInteger;
+    }
+
+// Arithmetic
+public:
+    static Number add(Number lhs, Number rhs){
+        if(lhs._isInteger && rhs._isInteger && isExact(lhs._integer + rhs._integer)){
+            return ofInteger(lhs._integer + rhs._integer);
+        }
+        return ofDouble(lhs.toDouble() + rhs.toDouble());
+    }
+
+    static Number subtract(Number lhs, Number rhs){
+        if(lhs._isInteger && rhs._isInteger && isExact(lhs._integer - rhs._integer)){
+            return ofInteger(lhs._integer - rhs._integer);
+        }
+        return ofDouble(lhs.toDouble() - rhs.toDouble());
+    }
+
+    static Number multiply(Number lhs, Number rhs){
+        if(lhs._isInteger && rhs._isInteger){
+            bool isSame = lhs._integer == 0 || std::llabs(rhs._integer) <= LargestExactInteger / std::llabs(lhs._integer);
+            int64_t value = isSame ? lhs._integer * rhs._integer : 0;
+            if(isSame && !(value == 0 && (lhs._integer < 0 || rhs._integer < 0))){
+                return ofInteger(value);
+            }
+        }
+        return ofDouble(lhs.toDouble() * rhs.toDouble());
+    }
+
+    static Number divide(Number lhs, Number rhs){
+        return ofDouble(lhs.toDouble() / rhs.toDouble());
+    }
+};
+
+#endif // NUMBER_H
@@ -1,9 +1,10 @@
 #ifndef LANGUAGEDICTIONARY_H
 #define LANGUAGEDICTIONARY_H
 
-#include <map>
-#include <string>
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 
 // Contains all the tokens and language keywords
 class LanguageDictionary{
@@ -44,11 +45,16 @@ public:
         DivisionToken,
         InputToken,
         RightShiftToken,
-        TypeStringToken
+        TypeStringToken,
+        WhileToken,
+        OpenBraceToken,         // Starts the body of a while. In the tree it links the statements of the body
+        CloseBraceToken         // Ends the body of a while (is not use in AST)
     };
+
+    static constexpr std::size_t TokenCount = CloseBraceToken + 1;         // Every token is below it
     
     // For RES_SYM.txt
-    std::vector<std::string> token_to_String = { 
+    static constexpr const char* token_to_String[] = { 
         "CharacterToken",
         "IdentifierToken",
         "NumberToken",
@@ -80,8 +86,21 @@ public:
         "DivisionToken",
         "InputToken",
         "RightShiftToken",
-        "TypeStringToken"
+        "TypeStringToken",
+        "WhileToken",
+        "OpenBraceToken",
+        "CloseBraceToken"
+    };
+
+    // Classes a single character can belong to. A character can be part of more than one class (e.g. '1' is both a digit and an identifier character)
+    enum CharacterClass : uint8_t{
+        NoClass             = 0,
+        IdentifierClass     = 1 << 0,   // a-z, A-Z, 0-9 and '_'
+        DigitClass          = 1 << 1,   // 0-9
+        OperatorClass       = 1 << 2,   // Every character that starts an operator (including '"')
+        WhiteSpaceClass     = 1 << 3    // ' ', '\t', '\n', '\v', '\f' and '\r'
     };
+
 private:
     LanguageDictionary(){}
     ~LanguageDictionary(){}
@@ -95,162 +114,231 @@ public:
     LanguageDictionary(LanguageDictionary const&) = delete;
     void operator=(LanguageDictionary const&) = delete;
 
+// Spellings of the language
 public:
+    struct Entry{
+        std::string_view    _spelling;
+        LanguageToken       _token;
+    };
+
+    static constexpr Entry _keywords[] = {
+        {"if",      LanguageToken::IfToken},
+        {"integer", LanguageToken::TypeIntegerToken},
+        {"double",  LanguageToken::TypeDoubleToken},
+        {"output",  LanguageToken::OutputToken},
+        {"input",   LanguageToken::InputToken},
+        {"string",  LanguageToken::TypeStringToken},
+        {"while",   LanguageToken::WhileToken}
+    };
+
+    static constexpr Entry _singleOperators[] = {
+        {"+",   LanguageToken::AdditionToken},
+        {"-",   LanguageToken::SubtractionToken},
+        {"*",   LanguageToken::MultiplicationToken},
+        {"/",   LanguageToken::DivisionToken},
+        {";",   LanguageToken::EndOfStatementToken},
+        {":",   LanguageToken::ColonToken},
+        {"=",   LanguageToken::EqualToken},
+        {"\"",  LanguageToken::QuoteToken},
+        {"(",   LanguageToken::OpenParenthesisToken},
+        {")",   LanguageToken::CloseParenthesisToken},
+        {"!",   LanguageToken::NotEqualToken},
+        {"<",   LanguageToken::LessThanToken},
+        {">",   LanguageToken::GreaterThanToken},
+        {"{",   LanguageToken::OpenBraceToken},
+        {"}",   LanguageToken::CloseBraceToken}
+    };
+
+    static constexpr Entry _doubleOperators[] = {
+        {":=",  LanguageToken::AssignmentToken},
+        {"==",  LanguageToken::EqualityToken},
+        {"!=",  LanguageToken::NotEqualToken},
+        {"<<",  LanguageToken::LeftShiftToken},
+        {">>",  LanguageToken::RightShiftToken}
+    };
+
+private:
+    // Collision-free table whose seed is searched at compile time so that every entry lands on its own slot.
+    // A lookup is therefore one hash and one string comparison.
+    template<std::size_t TableSize>
+    struct PerfectHash{
+        std::array<Entry, TableSize>    _slots{};
+        uint32_t                        _seed = 0;
+        bool                            _isPerfect = false;
+    };
 
-    std::map<std::string, LanguageToken>& getLanguageKeywords(){
-        return _languageKeywords;
+    // Only the length and the first and last character take part in the hash. That's enough to separate the keywords and operators of the language
+    static constexpr uint32_t hash(std::string_view value, uint32_t seed){
+        uint32_t h = seed ^ static_cast<uint32_t>(value.size());
+        h = (h ^ static_cast<unsigned char>(value.front())) * 16777619u;
+        h = (h ^ static_cast<unsigned char>(value.back())) * 16777619u;
+        return h ^ (h >> 15);
     }
 
-    std::map<std::string, LanguageToken>& getOperatorAlphabet(){
-        return _operatorAlphabet;
+    template<std::size_t TableSize, std::size_t EntryCount>
+    static constexpr PerfectHash<TableSize> buildPerfectHash(const Entry (&entries)[EntryCount]){
+        PerfectHash<TableSize> table{};
+        for(uint32_t seed = 1; seed < 100000; ++seed){
+            std::array<Entry, TableSize> slots{};
+            for(auto& slot : slots){
+                slot = {"", LanguageToken::InvalidToken};
+            }
+            bool hasCollision = false;
+            for(std::size_t i = 0; i < EntryCount && !hasCollision; ++i){
+                Entry& slot = slots[hash(entries[i]._spelling, seed) % TableSize];
+                if(slot._token != LanguageToken::InvalidToken){
+                    hasCollision = true;
+                }
+                slot = entries[i];
+            }
+            if(!hasCollision){
+                table._slots = slots;
+                table._seed = seed;
+                table._isPerfect = true;
+                return table;
+            }
+        }
+        return table;
     }
 
-    std::map<std::string , LanguageToken>& getConditionalOperator(){
-        return _conditionalOperator;
+    static constexpr std::array<LanguageToken, 256> buildSingleOperators(){
+        std::array<LanguageToken, 256> table{};
+        for(auto& token : table){
+            token = LanguageToken::InvalidToken;
+        }
+        for(const Entry& entry : _singleOperators){
+            table[static_cast<unsigned char>(entry._spelling[0])] = entry._token;
+        }
+        return table;
     }
-    
-    // You know, I could probably just do it with a simple if else statement by character comparison but I did it this way, so yeah....
-    std::map<char, LanguageToken>& getNumberAlphabet(){
-        return _numberAlphabet;
+
+    static constexpr std::array<uint8_t, 256> buildCharacterClasses(){
+        std::array<uint8_t, 256> table{};
+        for(int c = 'a'; c <= 'z'; ++c){ table[c] |= IdentifierClass; }
+        for(int c = 'A'; c <= 'Z'; ++c){ table[c] |= IdentifierClass; }
+        for(int c = '0'; c <= '9'; ++c){ table[c] |= IdentifierClass | DigitClass; }
+        table['_'] |= IdentifierClass;
+        for(const Entry& entry : _singleOperators){
+            table[static_cast<unsigned char>(entry._spelling[0])] |= OperatorClass;
+        }
+        for(char c : {' ', '\t', '\n', '\v', '\f', '\r'}){
+            table[static_cast<unsigned char>(c)] |= WhiteSpaceClass;
+        }
+        return table;
     }
-    
-    std::map<char, LanguageToken>& getAlphabet(){
-        return _alphabet;
+
+    // Defined after the class, since the builders can only be evaluated once the class is complete
+    static const std::array<uint8_t, 256>           _characterClass;
+    static const std::array<LanguageToken, 256>     _singleOperatorTable;
+    static const PerfectHash<16>                    _keywordTable;
+    static const PerfectHash<8>                     _doubleOperatorTable;
+
+    template<std::size_t TableSize>
+    static constexpr LanguageToken find(const PerfectHash<TableSize>& table, std::string_view value){
+        if(value.empty()){
+            return LanguageToken::InvalidToken;
+        }
+        const Entry& slot = table._slots[hash(value, table._seed) % TableSize];
+        return slot._spelling == value ? slot._token : LanguageToken::InvalidToken;
     }
 
-    std::map<std::string, LanguageToken>& getDoubleOperator(){
-        return _doubleOperator;
+// Lookups. None of these allocate
+public:
+
+    static constexpr uint8_t characterClass(char c){
+        return _characterClass[static_cast<unsigned char>(c)];
     }
 
-private:
-    std::map<std::string, LanguageToken> _languageKeywords ={
-        {"if", LanguageToken::IfToken},
-        {"integer", LanguageToken::TypeIntegerToken},
-        {"double", LanguageToken::TypeDoubleToken},
-        {"output", LanguageToken::OutputToken},
-        {"input", LanguageToken::InputToken},
-        {"string", LanguageToken::TypeStringToken}
-    };
+    // a-z, A-Z, 0-9 and '_'
+    static constexpr bool isIdentifier(char c){
+        return (characterClass(c) & IdentifierClass) != 0;
+    }
 
-    std::map<std::string, LanguageToken> _operatorAlphabet ={
-        {"+", LanguageToken::AdditionToken},
-        {"-", LanguageToken::SubtractionToken},
-        {"*", LanguageToken::MultiplicationToken},
-        {"/", LanguageToken::DivisionToken},
-        {";", LanguageToken::EndOfStatementToken},
-        {":", LanguageToken::ColonToken},
-        {":=", LanguageToken::AssignmentToken},
-        {"=", LanguageToken::EqualToken},
-        {"\"", LanguageToken::QuoteToken},
-        {"(", LanguageToken::OpenParenthesisToken},
-        {")", LanguageToken::CloseParenthesisToken},
-        {"!", LanguageToken::NotEqualToken},
-        {"<", LanguageToken::LessThanToken},
-        {">", LanguageToken::GreaterThanToken},
-        {"==", LanguageToken::EqualityToken},
-        {"!=", LanguageToken::NotEqualToken},
-        {"<<", LanguageToken::LeftShiftToken},
-        {">>", LanguageToken::RightShiftToken}
-    };
+    static constexpr bool isDigit(char c){
+        return (characterClass(c) & DigitClass) != 0;
+    }
 
-    std::map<std::string, LanguageToken> _conditionalOperator ={
-        {"<", LanguageToken::LessThanToken},
-        {">", LanguageToken::GreaterThanToken},
-        {"==", LanguageToken::EqualityToken},
-        {"!=", LanguageToken::NotEqualToken}
-    };
+    static constexpr bool isOperator(char c){
+        return (characterClass(c) & OperatorClass) != 0;
+    }
 
-    std::map<std::string, LanguageToken> _doubleOperator{
-        {"<<", LanguageToken::LeftShiftToken},
-        {":=", LanguageToken::AssignmentToken},
-        {"==", LanguageToken::EqualityToken},
-        {"!=", LanguageToken::NotEqualToken},
-        {">>", LanguageToken::RightShiftToken}
-    };
+    static constexpr bool isWhiteSpace(char c){
+        return (characterClass(c) & WhiteSpaceClass) != 0;
+    }
 
-    std::map<char, LanguageToken> _numberAlphabet ={
-        {'0', LanguageToken::NumberToken},
-        {'1', LanguageToken::NumberToken},
-        {'2', LanguageToken::NumberToken},
-        {'3', LanguageToken::NumberToken},
-        {'4', LanguageToken::NumberToken},
-        {'5', LanguageToken::NumberToken},
-        {'6', LanguageToken::NumberToken},
-        {'7', LanguageToken::NumberToken},
-        {'8', LanguageToken::NumberToken},
-        {'9', LanguageToken::NumberToken}
-    };
+    static constexpr LanguageToken operatorToken(char c){
+        return _singleOperatorTable[static_cast<unsigned char>(c)];
+    }
 
-    // Contains the alphabet of the language
-    // I used map because it's faster to search than normal looping
-    std::map<char, LanguageToken> _alphabet ={
-        {'a', LanguageToken::CharacterToken},
-        {'b', LanguageToken::CharacterToken},
-        {'c', LanguageToken::CharacterToken},
-        {'d', LanguageToken::CharacterToken},
-        {'e', LanguageToken::CharacterToken},
-        {'f', LanguageToken::CharacterToken},
-        {'g', LanguageToken::CharacterToken},
-        {'h', LanguageToken::CharacterToken},
-        {'i', LanguageToken::CharacterToken},
-        {'j', LanguageToken::CharacterToken},
-        {'k', LanguageToken::CharacterToken},
-        {'l', LanguageToken::CharacterToken},
-        {'m', LanguageToken::CharacterToken},
-        {'n', LanguageToken::CharacterToken},
-        {'o', LanguageToken::CharacterToken},
-        {'p', LanguageToken::CharacterToken},
-        {'q', LanguageToken::CharacterToken},
-        {'r', LanguageToken::CharacterToken},
-        {'s', LanguageToken::CharacterToken},
-        {'t', LanguageToken::CharacterToken},
-        {'u', LanguageToken::CharacterToken},
-        {'v', LanguageToken::CharacterToken},
-        {'w', LanguageToken::CharacterToken},
-        {'x', LanguageToken::CharacterToken},
-        {'y', LanguageToken::CharacterToken},
-        {'z', LanguageToken::CharacterToken},
-        {'A', LanguageToken::CharacterToken},
-        {'B', LanguageToken::CharacterToken},
-        {'C', LanguageToken::CharacterToken},
-        {'D', LanguageToken::CharacterToken},
-        {'E', LanguageToken::CharacterToken},
-        {'F', LanguageToken::CharacterToken},
-        {'G', LanguageToken::CharacterToken},
-        {'H', LanguageToken::CharacterToken},
-        {'I', LanguageToken::CharacterToken},
-        {'J', LanguageToken::CharacterToken},
-        {'K', LanguageToken::CharacterToken},
-        {'L', LanguageToken::CharacterToken},
-        {'M', LanguageToken::CharacterToken},
-        {'N', LanguageToken::CharacterToken},
-        {'O', LanguageToken::CharacterToken},
-        {'P', LanguageToken::CharacterToken},
-        {'Q', LanguageToken::CharacterToken},
-        {'R', LanguageToken::CharacterToken},
-        {'S', LanguageToken::CharacterToken},
-        {'T', LanguageToken::CharacterToken},
-        {'U', LanguageToken::CharacterToken},
-        {'V', LanguageToken::CharacterToken},
-        {'W', LanguageToken::CharacterToken},
-        {'X', LanguageToken::CharacterToken},
-        {'Y', LanguageToken::CharacterToken},
-        {'Z', LanguageToken::CharacterToken},
-        {'_', LanguageToken::CharacterToken},
-        {'0', LanguageToken::CharacterToken},
-        {'1', LanguageToken::CharacterToken},
-        {'2', LanguageToken::CharacterToken},
-        {'3', LanguageToken::CharacterToken},
-        {'4', LanguageToken::CharacterToken},
-        {'5', LanguageToken::CharacterToken},
-        {'6', LanguageToken::CharacterToken},
-        {'7', LanguageToken::CharacterToken},
-        {'8', LanguageToken::CharacterToken},
-        {'9', LanguageToken::CharacterToken},
-    };
+    static constexpr LanguageToken operatorToken(char c, char next){
+        const char value[2] = {c, next};
+        return find(_doubleOperatorTable, std::string_view(value, 2));
+    }
 
+    // Accepts both single and double operators
+    static constexpr LanguageToken operatorToken(std::string_view value){
+        if(value.size() == 1){
+            return operatorToken(value[0]);
+        }
+        if(value.size() == 2){
+            return find(_doubleOperatorTable, value);
+        }
+        return LanguageToken::InvalidToken;
+    }
+
+    static constexpr LanguageToken keywordToken(std::string_view value){
+        return find(_keywordTable, value);
+    }
 
+    static constexpr bool isKeyword(std::string_view value){
+        return keywordToken(value) != LanguageToken::InvalidToken;
+    }
+
+    static constexpr bool isOperator(std::string_view value){
+        return operatorToken(value) != LanguageToken::InvalidToken;
+    }
+
+    static constexpr bool isDoubleOperator(std::string_view value){
+        return value.size() == 2 && operatorToken(value) != LanguageToken::InvalidToken;
+    }
+
+    // <, >, == and !=
+    static constexpr bool isConditionalOperator(std::string_view value){
+        switch(operatorToken(value)){
+            case LanguageToken::LessThanToken:
+            case LanguageToken::GreaterThanToken:
+                return value.size() == 1;
+            case LanguageToken::EqualityToken:
+            case LanguageToken::NotEqualToken:
+                return value.size() == 2;
+            default:
+                return false;
+        }
+    }
 };
 
+inline constexpr std::array<uint8_t, 256>                               LanguageDictionary::_characterClass         = LanguageDictionary::buildCharacterClasses();
+inline constexpr std::array<LanguageDictionary::LanguageToken, 256>     LanguageDictionary::_singleOperatorTable    = LanguageDictionary::buildSingleOperators();
+inline constexpr LanguageDictionary::PerfectHash<16>                    LanguageDictionary::_keywordTable           = LanguageDictionary::buildPerfectHash<16>(LanguageDictionary::_keywords);
+inline constexpr LanguageDictionary::PerfectHash<8>                     LanguageDictionary::_doubleOperatorTable    = LanguageDictionary::buildPerfectHash<8>(LanguageDictionary::_doubleOperators);
+
+// Every spelling has to find itself again, otherwise no seed could separate them and the table size has to grow
+constexpr bool isDictionaryPerfect(){
+    for(const auto& entry : LanguageDictionary::_keywords){
+        if(LanguageDictionary::keywordToken(entry._spelling) != entry._token){ return false; }
+    }
+    for(const auto& entry : LanguageDictionary::_singleOperators){
+        if(LanguageDictionary::operatorToken(entry._spelling) != entry._token){ return false; }
+    }
+    for(const auto& entry : LanguageDictionary::_doubleOperators){
+        if(LanguageDictionary::operatorToken(entry._spelling) != entry._token){ return false; }
+    }
+    return true;
+}
+static_assert(isDictionaryPerfect(), "The keyword or double operator table is not a perfect hash");
+static_assert(!LanguageDictionary::isConditionalOperator("!"), "'!' alone is not a conditional operator");
+static_assert(sizeof(LanguageDictionary::token_to_String) / sizeof(LanguageDictionary::token_to_String[0]) == LanguageDictionary::TokenCount,
+              "Every token needs its name in token_to_String");
+
 
 #endif // LANGUAGEDICTIONARY_H
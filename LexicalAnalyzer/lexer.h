@@ -0,0 +1,257 @@
+#ifndef LEXER_H
+#define LEXER_H
+
+// Standard Libraries
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// Created Classes
+#include "../ErrorHandler/errorHandler.h"
+#include "../LanguageDictionary/LanguageDictionary.h"
+#include "../SourceBuffer/sourceScanner.h"
+#include "token.h"
+
+// An error found by a Lexer that defers its errors. Kept until the tokens before it were consumed
+struct LexerError{
+    std::string     _message;                                               // Same message that would go to the ErrorHandler
+    int             _line;                                                  // Line where the error was found
+    int             _column;                                                // Column where the error was found
+    std::size_t     _tokenIndex;                                            // Number of tokens returned before the error was found
+};
+
+/**
+ * Lexer
+ * - Splits a range of the source into tokens, one token per call to next().
+ * - Doesn't know about the AST. Whoever pulls the tokens decides what to do with them.
+ * - Tokens point into the source, so tokenizing never allocates.
+**/
+class Lexer{
+
+private:
+    // Alias LanguageToken to make things easier
+    using LanguageToken = LanguageDictionary::LanguageToken;
+
+private:
+    const char*     _source;                                                // Start of the whole source. Token offsets are relative to it
+    const char*     _cursor;                                                // Next character to be read from the source
+    const char*     _end;                                                   // One past the last character of the source
+    int             _line;                                                  // Current line. Used for Error handling
+    int             _column;                                                // Current column. Used for Error handling
+    Token           _previous;                                              // Previous token. Used for Sign Identification
+    std::size_t     _tokenCount             = 0;                            // Number of tokens returned so far
+    bool            _isDeferringErrors      = false;                        // Keep the errors in _errors instead of reporting them
+    std::vector<LexerError> _errors;                                        // Deferred errors, in the order they were found
+    ErrorHandler*   _errorHandler           = &ErrorHandler::getInstance(); // Used to report malformed tokens
+
+// Constructors
+public:
+    Lexer(const char* begin, const char* end, int line = 0) : Lexer(begin, begin, end, line){}
+
+    // Lexes [begin, end) of a bigger source that starts at `source`. `begin` has to be the start of a statement
+    Lexer(const char* source, const char* begin, const char* end, int line){
+        this->_source   = source;
+        this->_cursor   = begin;
+        this->_end      = end;
+        this->_line     = line;
+        this->_column   = 0;
+    }
+
+// Methods
+public:
+
+    // Reads the next token. Returns false once the source is exhausted
+    bool next(Token& token){
+
+        // Skip everything that can't start a token
+        while((_cursor = SourceScanner::skipWhiteSpace(_cursor, _end)) < _end){
+
+            // Get a character from the source
+            const char* start = _cursor;
+            char c = *_cursor++;
+
+            // Can Handle String Literals
+            if(c == '"'){
+                processStringLiteral(token, start);
+            }
+
+            // Can handle single or double operator or EndOfStatement Token
+            else if(LanguageDictionary::isOperator(c)){
+                processOperator(token, start);
+            }
+
+            // Ensure that this will only be called if the token starts with a digit
+            else if(LanguageDictionary::isDigit(c)){
+                processDigit(token, start);
+            }
+
+            // Can Handle Keywords
+            else if(LanguageDictionary::isIdentifier(c)){
+                processIdentifier(token, start);
+            }
+
+            // Not part of the language. Ignore it
+            else{
+                continue;
+            }
+
+            _previous = token;
+            _tokenCount++;
+            return true;
+        }
+        return false;
+    }
+
+    int getLine() const{
+        return _line;
+    }
+
+    int getColumn() const{
+        return _column;
+    }
+
+    // Errors are kept in getErrors() instead of going to the ErrorHandler. Used when lexing on another thread
+    void deferErrors(){
+        _isDeferringErrors = true;
+    }
+
+    const std::vector<LexerError>& getErrors() const{
+        return _errors;
+    }
+
+private:
+    void processDigit(Token& token, const char* start){
+
+        // Find the end of the number in one go
+        const char* numberEnd = SourceScanner::digitEnd(_cursor, _end);
+
+        this->_column += (int)(numberEnd - _cursor);
+        _cursor = numberEnd;
+
+        // A dot makes it a double. More than one dot is caught by the conversion below
+        bool isDouble = std::char_traits<char>::find(start, numberEnd - start, '.') != nullptr;
+        makeToken(token, isDouble ? LanguageToken::NumberDoubleToken : LanguageToken::NumberIntegerToken, start);
+
+        // Convert the literal once so no later stage has to parse it again. from_chars doesn't accept a leading '+'
+        const char* digits = *start == '+' ? start + 1 : start;
+        std::from_chars_result result;
+        if(isDouble){
+            result = std::from_chars(digits, numberEnd, token._number._double);
+        }else{
+            result = std::from_chars(digits, numberEnd, token._number._integer);
+        }
+
+        if(result.ec == std::errc::result_out_of_range){
+            reportError("Number literal [" + std::string(token._text) + "] is out of range ");
+        }else if(result.ec != std::errc() || result.ptr != numberEnd){
+            reportError("Invalid number literal [" + std::string(token._text) + "] ");
+        }
+    }
+
+    void processIdentifier(Token& token, const char* start){
+
+        // Find the end of the identifier in one go
+        const char* identifierEnd = SourceScanner::identifierEnd(_cursor, _end);
+        this->_column += (int)(identifierEnd - _cursor);
+        _cursor = identifierEnd;
+
+        // Keywords are spelled like identifiers
+        std::string_view text(start, _cursor - start);
+        LanguageToken keyword = LanguageDictionary::keywordToken(text);
+        makeToken(token, keyword != LanguageToken::InvalidToken ? keyword : LanguageToken::IdentifierToken, start);
+    }
+
+    void processOperator(Token& token, const char* start){
+        this->_column++;
+
+        char c = *start;
+
+        //  To Check if It's a double Operator
+        char next = _cursor < _end ? *_cursor : '\0';
+
+        LanguageToken doubleOperator = LanguageDictionary::operatorToken(c, next);
+
+        // Then it's a negative operator. Parentheses and braces are never part of a number
+        if((c != ')' && c != '(' && c != '{' && c != '}') && LanguageDictionary::isDigit(next) && detectIfASign()){
+            processDigit(token, start);
+        }
+
+        // If it's not a double operator, then append the normal operator
+        else if(doubleOperator == LanguageToken::InvalidToken){
+            makeToken(token, LanguageDictionary::operatorToken(c), start);
+        }
+
+        // Otherwise, append the double operator
+        else{
+            ++_cursor;
+            makeToken(token, doubleOperator, start);
+        }
+
+        // If it's a semicolon, the next token is on a new line
+        if(c == ';'){
+            this->_line++;                                                  // Increment the line
+            this->_column = 0;                                              // Reset the column
+        }
+
+        // The '}' of a while ends a statement too. Columns start again, the line doesn't
+        else if(c == '}'){
+            this->_column = 0;
+        }
+    }
+
+    void processStringLiteral(Token& token, const char* start){
+
+        // Find the closing quote
+        const char* quote = SourceScanner::findQuote(_cursor, _end);
+
+        // Everything before it is part of the literal
+        this->_column += (int)(quote - _cursor);
+
+        if(quote == _end){
+            _cursor = _end;
+            makeToken(token, LanguageToken::InvalidToken, start);
+            reportError("Unterminated string literal ");
+            return;
+        }
+        _cursor = quote + 1;
+        makeToken(token, LanguageToken::StringToken, start);
+    }
+
+    void makeToken(Token& token, LanguageToken kind, const char* start){
+        token._kind     = kind;
+        token._text     = std::string_view(start, _cursor - start);
+        token._offset   = (uint32_t)(start - _source);
+        token._line     = _line;
+        token._column   = _column;
+        token._number   = {0};
+    }
+
+    void reportError(std::string message){
+        if(_isDeferringErrors){
+            _errors.push_back({message, _line, _column, _tokenCount});
+            return;
+        }
+        _errorHandler->addError(message, _line, _column);
+    }
+
+// Checkers
+private:
+    bool detectIfASign(){
+        std::string_view previous = _previous._text;
+
+        // Nothing was read yet
+        bool isNull = (_previous._kind == LanguageToken::InvalidToken) && previous.empty();
+        bool isOperator = LanguageDictionary::isOperator(previous);
+        bool isPossible = previous != ")" && previous != "(";
+
+        if((isOperator || isNull) && isPossible){
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif // LEXER_H
@@ -8,11 +8,22 @@
 #include <utility>
 
 // Created Classes
+#include "../Options/options.h"
+#include "../SourceBuffer/sourceBuffer.h"
+#include "../BufferedWriter/bufferedWriter.h"
+#include "lexer.h"
+#include "parallelLexer.h"
+#include "token.h"
 #include "../SymbolTable/symbolTable.h"
 #include "../LanguageDictionary/LanguageDictionary.h"
-#include "../ErrorHandler/ErrorHandler.h"
+#include "../ErrorHandler/errorHandler.h"
 #include "../AbstractSyntaxTree/AbstractSyntaxTree.h"
+#include "../ProgramImage/programImage.h"
 #include "../Interpreter/Interpreter.h"
+#include "../StandardOutput/standardOutput.h"
+#include "../StandardInput/standardInput.h"
+#include "../VirtualMachine/bytecodeCompiler.h"
+#include "../VirtualMachine/virtualMachine.h"
 
 class LexicalAnalyzer{
 
@@ -22,6 +33,8 @@ private:
     ErrorHandler* _errorHandler;
     AST* _ast;
     Interpreter* _interpreter;
+    VirtualMachine* _virtualMachine;
+    StandardOutput* _output;
 
 private:
     
@@ -33,22 +46,35 @@ private:
 private:
 
     std::string     _filename               = "test.txt";                   // Default input filename
-    std::string     _outfile                = "NOSPACES.txt";                // Default output filename
-    std::ifstream   _file;                                                  // Input file stream
-    std::ofstream   _oFile;                                                 // Output file stream
+    std::string     _outfile                = "NOSPACES.txt";               // Default output filename
+    SourceBuffer    _source;                                                // The whole input file
+    bool            _writeNoSpaces          = false;                        // If the script without whitespace is written to the output file
+    unsigned        _threads                = 0;                            // Threads used for lexing and validation. 0 is one per core
+    bool            _useImage               = true;                         // Run from the program image of the script if there is one
+    std::string     _cacheDirectory         = "";                           // Where the program images go. Next to the script if empty
+    bool            _optimize               = false;                        // Run the whole script optimizer
+    Options::Engine _engine                 = Options::TreeEngine;          // What runs the script
+    bool            _isInputGood            = true;                         // If the input file of the script, when there is one, was opened
+    bool            _isTracing              = false;                        // If the syntax analyzer or the optimizer write what they do. Needs a real compile
     int             _line;                                                  // Current line. Used for Error handling
     int             _column;                                                // Current column. Used for Error handling
     int             _errorCount;                                            // Current error count for the file
-    std::string     _totalStringNoSpace     = "";                           // Total string without space. Use for the output file
-    LanguageToken   _prevToken              = LanguageToken::InvalidToken;  // Previous token. Used for Sign Identfication
-    std::string     _prevValue              = "";                           // Previous value. Used for Sign Identification
-    bool            _hasEndedSuccessfully   = false;                        // Check if the file has ended successfully with semicolon at the end
+    bool            _hasEndedSuccessfully   = false;                        // Check if the file has ended successfully with semicolon (or the '}' of a while) at the end
 
 // Constructors
 public:
-    LexicalAnalyzer(std::string filename = "test.txt"){
-
-        this->_filename             = filename;                             // Set the filename
+    LexicalAnalyzer(std::string filename = "test.txt") : LexicalAnalyzer(Options{filename}){}
+
+    LexicalAnalyzer(const Options& options) : _source(options._filename){
+
+        this->_filename             = options._filename;                    // Set the filename
+        this->_writeNoSpaces        = options._writeNoSpaces;               // Set if the output file is written
+        this->_threads              = options._threads;                     // Set the number of lexing and validation threads
+        this->_useImage             = options._useImage;                    // Set if the program image is used
+        this->_cacheDirectory       = options._cacheDirectory;              // Set where the program images go
+        this->_optimize             = options._optimize;                    // Set if the whole script optimizer runs
+        this->_engine               = options._engine;                      // Set what runs the script
+        this->_isTracing            = options._symbolTrace != Options::NoSymbolTrace || options._dumpTree;
         this->_line                 = 0;                                    // Signify the current line
         this->_column               = 0;                                    // Signify the current column
         this->_errorCount           = 0;                                    // Signify the current error count
@@ -56,132 +82,85 @@ public:
         this->_errorHandler         = &ErrorHandler::getInstance();         // Get the instance of the error handler
         this->_ast                  = &AST::getInstance();                  // Get the instance of the AST
         this->_interpreter          = &Interpreter::getInstance();          // Get the instance of the Interpreter
+        this->_virtualMachine       = &VirtualMachine::getInstance();       // Get the instance of the Virtual Machine
+        this->_output               = &StandardOutput::getInstance();       // Get the instance of the output of the script
+        if(options._outputBuffering != Options::AutoBuffering){
+            this->_output->setLineBuffered(options._outputBuffering == Options::LineBuffering);
+        }
+        this->_output->setDoubleFormat(options._doubleFormat);
+        if(!options._inputFile.empty() && !StandardInput::getInstance().open(options._inputFile)){
+            std::cout << "[!] Failed to open the input file [" << options._inputFile << "]. Maybe it's not existing" << std::endl;
+            this->_isInputGood = false;
+        }
         
 
+        // Symbol trace of the syntax analyzer
+        if(options._symbolTrace == Options::TextSymbolTrace){
+            this->_ast->openSymbolTrace("RES_SYM.txt", false);
+        }else if(options._symbolTrace == Options::BinarySymbolTrace){
+            this->_ast->openSymbolTrace("RES_SYM.bin", true);
+        }
+
+        // Trees before and after the optimizer
+        if(options._dumpTree){
+            this->_ast->openTreeDump("TREE.txt");
+        }
+
         // Input File
-        this->_file.open(filename);                                         // Open the file
         if(!isInFileGood()){return;}                                        // Check if the file is good
-        
-        // Output File
-        this->_oFile.open(_outfile);                                        // Open the file
-        if(!isOutFileGood()){return;}                                       // Check if the file is good
     }
 
     ~LexicalAnalyzer(){
-        this->closeFiles(0, _filename);                                    // Close the input file to avoid memory leak
-        this->closeFiles(1, _outfile);                                     // Close the output file to avoid memory leak
+        this->_ast->release();                                              // Free every tree of this file at once
     }
 
 // Methods
 public:
 
     void analyze(){
-
-        // Check if the file is open
-        while(_file.is_open()){
-            // If it's, then check if it's good
-            while(_file.good()){
-
-                // Container of the character
-                char c = ' ';
-                
-                // Get a character from the file
-                _file.get(c);
-                
-                if(_file.eof()){
-                    break;
-                }
-
-                // Peek the next character
-                char next = _file.peek();
-                
-                // Check if the character is a digit
-                bool isDigit        = this->isDigit(c)      != LanguageToken::InvalidToken;
-                bool isIdentifier   = this->isIdentifier(c) != LanguageToken::InvalidToken;
-                bool isOperator     = this->isOperator(c)   != LanguageToken::InvalidToken;
-                
-
-                // Can Handle String Literals
-                if(c == '"'){
-                    _totalStringNoSpace += c;                               // Add the current character to the total string
-                    processStringLiteral();                                 // Process the string literal
-                    _hasEndedSuccessfully = false;                          // Set the flag to false
-                }
- 
-                // Can handle single or double operator or EndOfStatement Token
-                else if(isOperator){
-
-                    _totalStringNoSpace += c;                               // Add the current character to the total string
-                    processOperator(c);                                     // Process the operator
-                    _hasEndedSuccessfully = false;                          // Set the flag to false
-                    // If it's a semicolon
-                    if(c == ';'){
-                        this->_line++;                                      // Increment the line
-                        this->_column = 0;                                  // Reset the column
-                        _hasEndedSuccessfully = true;                          // Set the flag to false
-                    }
-                }
-
-                // Ensure that this will only be called if the token starts with a digit
-                else if(isDigit){
-                    _totalStringNoSpace += c;                               // Add the current character to the total string
-                    processDigit(c);                                        // Process the digit
-                    _hasEndedSuccessfully = false;                          // Set the flag to false
-                }
-
-                // Can Handle Keywords
-                else if(isIdentifier){
-                    _totalStringNoSpace += c;                               // Add the current character to the total string
-                    processIdentifier(c);                                   // Process the identifier
-                    _hasEndedSuccessfully = false;                          // Set the flag to false
-                }
-            }
-            _file.close();
+        if(!_isInputGood){
+            return;
         }
 
-        if(!_hasEndedSuccessfully){
-            _errorHandler->addError("No semicolon at the end of the file",_line, _column);
+        // Compiled before. Straight to the interpreter
+        std::string imagePath;
+        uint64_t sourceHash = 0;
+        if(_useImage && _source.isGood() && _filename != "-"){
+            sourceHash = ProgramImage::hashSource(_source.begin(), _source.end(), _optimize);
+            imagePath = ProgramImage::pathFor(_filename, _cacheDirectory, sourceHash, _optimize);
         }
-
+        bool isLoaded = !imagePath.empty() && !_isTracing && _ast->loadImage(imagePath, sourceHash, _source.size());
 #ifdef DEBUG
-        std::cout << "[/] Lexical Analyzer has Successfully Finished. Going to the next Phase (Syntax Analyzer)" << std::endl;
-#endif
-        // Check for Syntax Error
-        _ast->evaluateTree();
-
-        // Display the error if there is any
-        if(_errorHandler->displayError()){
-            // If there is an error, then don't continue to the next phase
-            std::cout << "[!] Will not continue to the next phase" << std::endl;
-            std::cout << "[!] Please fix the error(s) above" << std::endl;
-            return;
+        if(isLoaded){
+            std::cout << "[/] Loaded the program image [" << imagePath << "]. Going to the next Phase (Interpreting)" << std::endl;
         }
-
-#ifdef DEBUG 
-            std::cout << "[/] Syntax Analyzer Successfuly Finished. Tree has been created and validated. Going to the next Phase (Interpreting)" << std::endl;
-
-    #ifdef DEBUG_AST_BEFORE_INTERPRETER
-            _ast->print();
-    #endif
-
 #endif
-        auto trees = _ast->getTrees();
-        for(auto tree : trees){
-            _interpreter->interpret(tree);
+        if(!isLoaded){
+            if(!compile()){
+                return;
+            }
+            if(!imagePath.empty()){
+                _ast->saveImage(imagePath, sourceHash, _source.size());
+            }
+        }
 
-#ifdef DEBUG 
-        #ifdef DEBUG_AST_INSIDE_INTERPRETER
-            std::cout << "[/] Succesfuly Interpreter" << std::endl;
-        #endif
-#endif
+        // What the script printed is written out before the error that stops it
+        try{
+            run();
+        }catch(...){
+            _output->flush();
+            throw;
         }
+        _output->flush();
 
 #ifdef DEBUG 
     #ifdef DEBUG_AST_AFTER_INTERPRETER
             _ast->print();
     #endif
 #endif
-        _oFile << _totalStringNoSpace;                                     // Put all the string with no space in the output file
+        if(_writeNoSpaces){
+            writeNoSpaces();                                                // Put all the string with no space in the output file
+        }
     }
 
     bool isEndOfStatement(char c){
@@ -192,244 +171,91 @@ public:
     }
 
 
+// Others
 private:
-    void processDigit(char c){
-
-        std::string total_value = std::string(1,c); 
-
-        // Flags
-        bool isDouble = false;
-        bool isDigit = false;
-        bool isAlreadyContainsDot = false;
-
-        // Create a storage for the character
-        char tempC = _file.peek();
-
-        // Check if the character is a digit
-        isDigit = this->isDigit(tempC) != LanguageToken::InvalidToken || tempC == '.';
 
-        if(isDigit){
-            _file.get(tempC);
-        }
-        
-        // If it's a digit, then loop until it's not a digit
-        while(isDigit){
-            this->_column++;
-
-            if(tempC == '.'){
-                if(isAlreadyContainsDot){
-                    // ERROR
-                    std::cout << "Invalid Token" << std::endl;
-                }
-                isDouble = true;
-                isAlreadyContainsDot = true;
-            }
-
-            // Append the character to the data_value
-            total_value += tempC;
-            _totalStringNoSpace += tempC;
-
-            tempC = _file.peek();
-
-            // Check if the character is a digit
-            isDigit = this->isDigit(tempC) != LanguageToken::InvalidToken || tempC == '.';
-            if(!isDigit){
-                break;
+    void run(){
+        const CompactTree& trees = _ast->getTrees();
+        if(_engine == Options::VirtualMachineEngine){
+            BytecodeCompiler compiler(trees);
+            Bytecode::Program program;
+            for(std::size_t next = 0; next < trees.getStatementCount();){
+                next = compiler.compile(next, program);
+                _virtualMachine->run(program);
             }
-
-            // Get the next character
-            _file.get(tempC);
-
-        }
-
-        if(isDouble){
-            _ast->insert(LanguageToken::NumberDoubleToken, total_value, _line, _column);
-            _prevToken = LanguageToken::NumberDoubleToken;
-            _prevValue = total_value;
         }else{
-            _ast->insert(LanguageToken::NumberIntegerToken, total_value, _line, _column);
-            _prevToken = LanguageToken::NumberIntegerToken;
-            _prevValue = total_value;
-        }
-
-    }
-
-    void processIdentifier(char c){
-
-        // Contains the total value of the identifier
-        std::string total_value = std::string(1,c); 
-
-        // Create a storage for the character
-        char tempC = _file.peek();
-
-        // Check if the character is in the alphabet
-        bool isIdentifier = this->isIdentifier(tempC) != LanguageToken::InvalidToken;
+            for(std::size_t i = 0; i < trees.getStatementCount(); ++i){
+                _interpreter->interpret(trees, trees.getRoot(i));
 
-        if(isIdentifier){
-            _file.get(tempC);
-        }
-        
-        // If it's a digit, then loop until it's not a digit
-        while(isIdentifier){
-            this->_column++;
-
-            // Append the character to the data_value
-            total_value += tempC;
-            _totalStringNoSpace += tempC;
-
-            tempC = _file.peek();
-
-            isIdentifier = this->isIdentifier(tempC) != LanguageToken::InvalidToken;
-
-            // Check if the character is a digit
-            if(!isIdentifier){
-                break;
+#ifdef DEBUG 
+            #ifdef DEBUG_AST_INSIDE_INTERPRETER
+                _output->flush();
+                std::cout << "[/] Succesfuly Interpreter" << std::endl;
+            #endif
+#endif
             }
-
-            // Get the next character
-            _file.get(tempC);
-
-        }
-
-        if(this->isKeyword(total_value) != LanguageToken::InvalidToken){
-            //char next = _file.peek();
-            LanguageToken nextToken = this->isKeyword(total_value);
-            _ast->insert(nextToken, total_value, _line, _column);
-            _prevToken = nextToken;
-            _prevValue = total_value;
-        }else{
-            _ast->insert(LanguageToken::IdentifierToken, total_value, _line, _column);
-            _prevToken = LanguageToken::IdentifierToken;
-            _prevValue = total_value;
         }
-
     }
 
-    void processOperator(char c){
-        this->_column++;
-
-        //  To Check if It's a double Operator
-        char next = _file.peek();
-        
-        // Create a possible double operator
-        std::string possibleDoubleOperator = std::string(1,c) + std::string(1,next);
+    // Lexer, parser and syntax analyzer. Returns false if the script has errors, they are already displayed
+    bool compile(){
 
-        // Check if it's a double operator
-        bool isDoubleOperator = this->isOperator(possibleDoubleOperator) != LanguageToken::InvalidToken;
-        bool isDigit = this->isDigit(next) != LanguageToken::InvalidToken;
+        // Lex the source and hand the tokens to the AST in source order
+        _ast->reserveFor(_source.size());
+        ParallelLexer lexer(_source.begin(), _source.end(), _threads);
+        lexer.run([this](const Token& token){
+            _hasEndedSuccessfully = token._kind == LanguageToken::EndOfStatementToken || token._kind == LanguageToken::CloseBraceToken;
 
-        // Then it's a negative operator
-        if((c != ')' && c != '(')&& isDigit && detectIfASign(c)){
-            processDigit(c);
-            return;
-        }
+            // Invalid tokens were already reported by the lexer
+            if(token._kind == LanguageToken::InvalidToken){
+                return;
+            }
+            _ast->insert(token);
+        });
+        _line = lexer.getLine();
+        _column = lexer.getColumn();
+        _ast->endSource(_line, _column);
 
-        // If it's not a double operator, then append the normal operator
-        if(!isDoubleOperator){
-            // Insert the operator
-            LanguageToken nextToken = this->isOperator(c);
-            _ast->insert(nextToken, std::string(1,c), _line, _column);
-            _prevToken = nextToken;
-            _prevValue = std::string(1,c);
-        }
-        
-        // Otherwise, append the double operator
-        else{
-            // Insert the double operator
-            LanguageToken nextToken = this->isOperator(possibleDoubleOperator);
-            _ast->insert(nextToken, possibleDoubleOperator, _line, _column);
-            _prevToken = nextToken;
-            _prevValue = possibleDoubleOperator;
-            _file.get(c);
-            _totalStringNoSpace += c;
+        if(!_hasEndedSuccessfully){
+            _errorHandler->addError("No semicolon at the end of the file",_line, _column);
         }
-    }
 
-    void processStringLiteral(){
-        std::string total_value = "\"";
-
-        // Create a storage for the character
-        char tempC = ' ';
-
-        // Get the next character
-        _file.get(tempC);
-
-        while(tempC != '"'){
-            this->_column++;
-            total_value += tempC;
-            _totalStringNoSpace += tempC;
+#ifdef DEBUG
+        std::cout << "[/] Lexical Analyzer has Successfully Finished. Going to the next Phase (Syntax Analyzer)" << std::endl;
+#endif
+        // Check for Syntax Error
+        _ast->evaluateTree(_threads);
 
-            _file.get(tempC);
+        // Check for variables used before they are declared
+        _ast->resolveVariables();
 
-            if(_file.eof()){
-                // ERROR
-                std::cout << "Invalid Token" << std::endl;
-                return;
-            }
+        // Check that strings and numbers aren't mixed
+        _ast->checkTypes();
 
-        }
-        total_value += "\"";
-        _totalStringNoSpace += tempC;
-        _ast->insert(LanguageToken::StringToken, total_value, _line, _column);
-        _prevToken = LanguageToken::StringToken;
-        _prevValue = total_value;
-    }
-
-// Checkers
-private:
-    bool detectIfASign(char c){
-        bool isOperator = false;
-        bool isNull = (_prevToken == LanguageToken::InvalidToken) && (_prevValue == "");
-        bool isDoubleOperator = this->isOperator(_prevValue) != LanguageToken::InvalidToken;
-        bool isPossible = _prevValue != ")" && _prevValue != "(";
-        if(_prevValue.length() == 1){
-            c = _prevValue[0];
-            isOperator = this->isOperator(c) != LanguageToken::InvalidToken;
-            isDoubleOperator = false;
+        // Display the error if there is any
+        if(_errorHandler->displayError()){
+            // If there is an error, then don't continue to the next phase
+            std::cout << "[!] Will not continue to the next phase" << std::endl;
+            std::cout << "[!] Please fix the error(s) above" << std::endl;
+            return false;
         }
 
-        if((isOperator || isDoubleOperator || isNull) && isPossible){
-            return true;
-        }
-        return false;
-    }
+        // Fold what can be known before running it
+        _ast->optimizeTree(_optimize);
 
-    // Check if the character is a valid identifier
-    LanguageToken isIdentifier(char c){
-        auto alphabet = this->_languageDictionary->getAlphabet();
-        return alphabet.find(c) != alphabet.end() ? alphabet[c] : LanguageToken::InvalidToken;
-    }
+#ifdef DEBUG 
+            std::cout << "[/] Syntax Analyzer Successfuly Finished. Tree has been created and validated. Going to the next Phase (Interpreting)" << std::endl;
 
-    
-    // Check if the character is a valid digit
-    LanguageToken isDigit(char c){
-        auto numberAlphabet = this->_languageDictionary->getNumberAlphabet();
-        return numberAlphabet.find(c) != numberAlphabet.end() ? numberAlphabet[c] : LanguageToken::InvalidToken;
-    }
-    
-    // Check if the character is a valid operator
-    LanguageToken isOperator(char c){
-        auto alphabet = this->_languageDictionary->getOperatorAlphabet();
-        std::string str = std::string(1,c);
-        return alphabet.find(str) != alphabet.end() ? alphabet[str] : LanguageToken::InvalidToken;
-    }
+    #ifdef DEBUG_AST_BEFORE_INTERPRETER
+            _ast->print();
+    #endif
 
-    LanguageToken isOperator(std::string str){
-        auto alphabet = this->_languageDictionary->getOperatorAlphabet();
-        return alphabet.find(str) != alphabet.end() ? alphabet[str] : LanguageToken::InvalidToken;
-    }
-   
-    // Check if the character is a valid keyword
-    LanguageToken isKeyword(std::string str){
-        auto keywords = this->_languageDictionary->getLanguageKeywords();
-        return keywords.find(str) != keywords.end() ? keywords[str] : LanguageToken::InvalidToken;;
+#endif
+        return true;
     }
 
-// Others
-private:
-
     bool isInFileGood(){
-        if(_file.is_open()){
+        if(_source.isGood()){
 #ifdef DEBUG
                 std::cout << "[/] Successfuly Open the file" << std::endl;
 #endif
@@ -440,30 +266,23 @@ private:
         return true;
 
     }
-    bool isOutFileGood(){
-        if(_oFile.is_open()){
-#ifdef DEBUG
-            std::cout << "[/] Successfuly Open the file" << std::endl;
-#endif
-        }else{
-            std::cout << "[!] Failed to open the file [" << _outfile << "]. Maybe it's not existing" << std::endl;
-            return false;
+    // The tokens are read again from the source instead of being kept around during the whole run.
+    // Only called once the lexer went through the source without errors, so this pass can't report anything new
+    void writeNoSpaces(){
+        BufferedWriter writer(_outfile);
+        if(!writer.isGood()){
+            return;
         }
-        return true;
-    }
 
-    void closeFiles(int fileIndex, std::string filename){
-        if(fileIndex == 0){
-            _file.close();
-#ifdef DEBUG
-            std::cout << "[/] Successfuly Closed the file [" << filename << "]" << std::endl;
-#endif
-        }else{
-            _oFile.close();
+        Lexer lexer(_source.begin(), _source.end());
+        Token token;
+        while(lexer.next(token)){
+            writer.write(token._text);
+        }
+        writer.close();
 #ifdef DEBUG
-            std::cout << "[/] Successfuly Closed the file [" << filename << "]" << std::endl;
+        std::cout << "[/] Successfuly Closed the file [" << _outfile << "]" << std::endl;
 #endif
-        }
     }
 
 };
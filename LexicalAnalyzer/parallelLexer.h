@@ -0,0 +1,173 @@
+#ifndef PARALLELLEXER_H
+#define PARALLELLEXER_H
+
+// Standard Libraries
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Created Classes
+#include "../ErrorHandler/errorHandler.h"
+#include "../SourceBuffer/sourceScanner.h"
+#include "../WorkerPool/workerPool.h"
+#include "lexer.h"
+#include "token.h"
+
+/**
+ * Parallel Lexer
+ * - Splits the source into chunks of about ChunkSize bytes at the ';' that are outside of string literals, and lexes them on a WorkerPool.
+ * - The tokens are handed out in source order, exactly as a single Lexer would produce them.
+ *   Lines are fixed up with the number of statements of the chunks before, errors are reported right before the token they were found at.
+ * - A chunk is consumed as soon as it's done, so the consumer works while the later chunks are still being lexed. The workers only get
+ *   a few chunks per thread ahead of it (see WorkerPool), so the tokens waiting for the consumer take the same memory for any size of script.
+**/
+class ParallelLexer{
+
+private:
+    static constexpr std::size_t MinimumSourceSize = 256 * 1024;           // Smaller sources aren't worth the threads
+    static constexpr std::size_t ChunkSize = 32 * 1024;                     // Bytes a worker lexes at once. Its tokens take about 20 times that
+
+    // Everything one worker produced
+    struct Chunk{
+        const char*             _begin          = nullptr;                  // Start of the chunk. Always the start of a statement
+        const char*             _end            = nullptr;                  // One past the last character of the chunk
+        std::vector<Token>      _tokens;                                    // Tokens with lines relative to the chunk
+        std::vector<LexerError> _errors;                                    // Errors with lines relative to the chunk
+        int                     _lines          = 0;                        // Number of statements ended in the chunk
+        int                     _column         = 0;                        // Column after the last token
+    };
+
+private:
+    const char*     _begin;                                                 // Start of the source
+    const char*     _end;                                                   // One past the last character of the source
+    unsigned        _threads;                                               // Workers that lex the chunks
+    int             _line           = 0;                                    // Line after the last token
+    int             _column         = 0;                                    // Column after the last token
+    ErrorHandler*   _errorHandler   = &ErrorHandler::getInstance();         // Where the errors of every chunk end up
+
+// Constructors
+public:
+    // 0 threads means one per core
+    ParallelLexer(const char* begin, const char* end, unsigned threads = 0){
+        this->_begin    = begin;
+        this->_end      = end;
+        this->_threads  = threads != 0 ? threads : std::thread::hardware_concurrency();
+        if(this->_threads == 0){
+            this->_threads = 1;
+        }
+    }
+
+// Methods
+public:
+
+    // Calls consume(const Token&) for every token in source order
+    template<typename Consumer>
+    void run(Consumer consume){
+
+        // Not worth it. Lex it right here without buffering the tokens
+        bool isWorthIt = _threads > 1 && (std::size_t)(_end - _begin) >= MinimumSourceSize;
+        std::vector<const char*> splits = isWorthIt ? split(_begin, _end) : std::vector<const char*>{_begin, _end};
+        if(splits.size() <= 2){
+            Lexer lexer(_begin, _end);
+            Token token;
+            while(lexer.next(token)){
+                consume(token);
+            }
+            _line = lexer.getLine();
+            _column = lexer.getColumn();
+            return;
+        }
+
+        // Hand out the chunks in order. Every chunk starts right after a ';' so only the line needs to be offset.
+        // The pool frees every chunk once it's consumed
+        int lineOffset = 0;
+        WorkerPool pool(_threads);
+        pool.run<Chunk>(splits.size() - 1,
+            [this, &splits](std::size_t block, Chunk& chunk){
+                chunk._begin = splits[block];
+                chunk._end = splits[block + 1];
+                lexChunk(_begin, chunk);
+            },
+            [this, &consume, &lineOffset](Chunk& chunk){
+                std::size_t nextError = 0;
+                for(std::size_t index = 0; index < chunk._tokens.size(); ++index){
+                    nextError = reportErrors(chunk, nextError, index, lineOffset);
+                    Token& token = chunk._tokens[index];
+                    token._line += lineOffset;
+                    consume(token);
+                }
+                reportErrors(chunk, nextError, chunk._tokens.size(), lineOffset);
+
+                lineOffset += chunk._lines;
+                _column = chunk._column;
+            });
+        _line = lineOffset;
+    }
+
+    int getLine() const{
+        return _line;
+    }
+
+    int getColumn() const{
+        return _column;
+    }
+
+    /**
+     * Pre-scan for the chunk boundaries.
+     * - Returns the start of every chunk followed by `end`. Every boundary is right after a ';' outside of a string literal.
+     * - Every chunk but the last is at least `chunkSize` bytes, and a statement longer.
+    **/
+    static std::vector<const char*> split(const char* begin, const char* end, std::size_t chunkSize = ChunkSize){
+        std::vector<const char*> splits{begin};
+
+        const char* cursor = begin;
+        while(cursor < end){
+            const char* boundary = SourceScanner::findStatementEnd(cursor, end);
+            if(boundary == end){
+                break;
+            }
+
+            // Skip the whole string literal. An unterminated one runs until the end of the source
+            if(*boundary == '"'){
+                const char* quote = SourceScanner::findQuote(boundary + 1, end);
+                cursor = quote == end ? end : quote + 1;
+                continue;
+            }
+
+            cursor = boundary + 1;
+            if((std::size_t)(cursor - splits.back()) >= chunkSize && cursor < end){
+                splits.push_back(cursor);
+            }
+        }
+        splits.push_back(end);
+        return splits;
+    }
+
+private:
+    static void lexChunk(const char* source, Chunk& chunk){
+        Lexer lexer(source, chunk._begin, chunk._end, 0);
+        lexer.deferErrors();
+
+        // Tokens are at least one character long, and usually a lot more with the whitespace
+        chunk._tokens.reserve((std::size_t)(chunk._end - chunk._begin) / 4);
+
+        Token token;
+        while(lexer.next(token)){
+            chunk._tokens.push_back(token);
+        }
+        chunk._errors = lexer.getErrors();
+        chunk._lines = lexer.getLine();
+        chunk._column = lexer.getColumn();
+    }
+
+    // Reports the errors found before the token at `index`. Returns the first error that wasn't reported
+    std::size_t reportErrors(const Chunk& chunk, std::size_t nextError, std::size_t index, int lineOffset){
+        while(nextError < chunk._errors.size() && chunk._errors[nextError]._tokenIndex <= index){
+            const LexerError& error = chunk._errors[nextError++];
+            _errorHandler->addError(error._message, error._line + lineOffset, error._column);
+        }
+        return nextError;
+    }
+};
+
+#endif // PARALLELLEXER_H
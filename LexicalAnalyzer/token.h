@@ -0,0 +1,34 @@
+#ifndef TOKEN_H
+#define TOKEN_H
+
+// Standard Libraries
+#include <cstdint>
+#include <string_view>
+
+// Created Classes
+#include "../LanguageDictionary/LanguageDictionary.h"
+
+// Binary value of a number literal. Which member is set depends on the token (NumberIntegerToken or NumberDoubleToken)
+union NumericValue{
+    int64_t     _integer;
+    double      _double;
+};
+
+/**
+ * Token
+ * - A single token produced by the Lexer.
+ * - The text points into the source buffer, so the buffer has to outlive the token.
+ * - Number literals are converted once by the lexer and carried in _number.
+**/
+struct Token{
+    using LanguageToken = LanguageDictionary::LanguageToken;
+
+    LanguageToken       _kind       = LanguageToken::InvalidToken;  // What kind of token it is. InvalidToken marks text that isn't a valid token (e.g. an unterminated string)
+    std::string_view    _text;                                      // The spelling of the token in the source
+    uint32_t            _offset     = 0;                            // Byte offset of the token from the start of the source
+    int                 _line       = 0;                            // Line where the token is. Used for Error handling
+    int                 _column     = 0;                            // Column where the token is. Used for Error handling
+    NumericValue        _number     = {0};                          // Value of the number literal
+};
+
+#endif // TOKEN_H
@@ -0,0 +1,153 @@
+#ifndef NUMBERTEXT_H
+#define NUMBERTEXT_H
+
+// Standard Libraries
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+/**
+ * Number Text
+ * - Every conversion between a number and its text that happens while a script runs: printing (StandardOutput), reading an
+ *   input, and the numbers the optimizer passes add to the trees.
+ * - Built on std::to_chars and std::from_chars: no locale, no allocation, no exception.
+ * - Writes a double two ways:
+ *      - StreamFormat, what std::cout writes by default: 6 significant digits, "%g". What scripts have always printed
+ *      - ShortestFormat, the shortest text that reads back as the same double
+ * - Reads numbers exactly like std::stoi and std::stod: leading whitespace is skipped, what follows the number is ignored,
+ *   and no digits at all is Invalid. A result beyond int, or beyond double, is OutOfRange.
+**/
+struct NumberText{
+
+    enum Format{
+        StreamFormat,                                                       // 6 significant digits, like std::cout. The default
+        ShortestFormat                                                      // Shortest round trip
+    };
+
+    enum Status{
+        Parsed,
+        Invalid,                                                            // std::stoi/stod would throw std::invalid_argument
+        OutOfRange                                                          // std::stoi/stod would throw std::out_of_range
+    };
+
+    static constexpr std::size_t MaxLength = 32;                            // Longest text written, there's always room for one more character
+    static constexpr int StreamPrecision = 6;                               // Default precision of std::ostream
+
+// Writing. `text` has room for MaxLength characters, the end of what was written is returned
+public:
+    static char* writeInteger(char* text, int64_t value){
+        return std::to_chars(text, text + MaxLength, value).ptr;
+    }
+
+    static char* writeDouble(char* text, double value, Format format = StreamFormat){
+        if(format == ShortestFormat){
+            return std::to_chars(text, text + MaxLength, value).ptr;
+        }
+        return std::to_chars(text, text + MaxLength, value, std::chars_format::general, StreamPrecision).ptr;
+    }
+
+    static std::string toString(int64_t value){
+        char text[MaxLength];
+        return std::string(text, writeInteger(text, value));
+    }
+
+    static std::string toString(double value, Format format = StreamFormat){
+        char text[MaxLength];
+        return std::string(text, writeDouble(text, value, format));
+    }
+
+// Reading
+public:
+    // Same as std::stoi
+    static Status readInteger(std::string_view text, int& value){
+        const char* begin = skipWhiteSpace(text.data(), text.data() + text.size());
+        const char* end = text.data() + text.size();
+        bool isNegative = begin != end && *begin == '-';
+        const char* digits = begin != end && (*begin == '-' || *begin == '+') ? begin + 1 : begin;
+        if(digits == end || *digits < '0' || *digits > '9'){
+            return Invalid;
+        }
+
+        // Read without the sign so the lowest value doesn't overflow, like strtol does
+        uint64_t magnitude = 0;
+        std::from_chars_result result = std::from_chars(digits, end, magnitude);
+        uint64_t limit = isNegative ? (uint64_t)INT_MAX + 1 : (uint64_t)INT_MAX;
+        if(result.ec == std::errc::result_out_of_range || magnitude > limit){
+            return OutOfRange;
+        }
+        value = isNegative ? (int)(0 - magnitude) : (int)magnitude;
+        return Parsed;
+    }
+
+    // Same as std::stod
+    static Status readDouble(std::string_view text, double& value){
+        const char* begin = skipWhiteSpace(text.data(), text.data() + text.size());
+        const char* end = text.data() + text.size();
+        bool isNegative = begin != end && *begin == '-';
+        const char* digits = begin != end && (*begin == '-' || *begin == '+') ? begin + 1 : begin;
+
+        // from_chars takes a '-' of its own. A second sign is no number for stod either
+        if(digits != begin && digits != end && *digits == '-'){
+            return Invalid;
+        }
+
+        // The common case: a decimal number from_chars reads the same way, to a normal double or a plain 0
+        bool isHexadecimal = end - digits >= 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X');
+        if(!isHexadecimal){
+            std::from_chars_result result = std::from_chars(digits, end, value);
+            if(result.ec == std::errc::invalid_argument){
+                return Invalid;
+            }
+            bool isExact = std::isnormal(value) || std::isinf(value) || std::isnan(value) || (value == 0.0 && !hasNonZeroDigit(digits, result.ptr));
+            if(result.ec == std::errc() && isExact){
+                value = isNegative ? -value : value;
+                return Parsed;
+            }
+        }
+
+        // Hexadecimal, too large, or too small to be normal: strtod decides, since stod throws whenever it sets ERANGE
+        std::string copy(begin, end);
+        char* parsedEnd = nullptr;
+        int savedErrno = errno;
+        errno = 0;
+        double parsed = std::strtod(copy.c_str(), &parsedEnd);
+        bool isOutOfRange = errno == ERANGE;
+        errno = savedErrno;
+        if(parsedEnd == copy.c_str()){
+            return Invalid;
+        }
+        if(isOutOfRange){
+            return OutOfRange;
+        }
+        value = parsed;
+        return Parsed;
+    }
+
+private:
+    // Same characters as isspace() in the C locale
+    static const char* skipWhiteSpace(const char* begin, const char* end){
+        while(begin != end && (*begin == ' ' || (*begin >= '\t' && *begin <= '\r'))){
+            ++begin;
+        }
+        return begin;
+    }
+
+    // If the mantissa of a decimal number has a digit other than 0, so a 0 result is an underflow
+    static bool hasNonZeroDigit(const char* begin, const char* end){
+        for(; begin != end && *begin != 'e' && *begin != 'E'; ++begin){
+            if(*begin >= '1' && *begin <= '9'){
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif // NUMBERTEXT_H
@@ -0,0 +1,644 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+// Standard Libraries
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Created Classes
+#include "../LanguageDictionary/LanguageDictionary.h"
+#include "../AbstractSyntaxTree/CompactTree.h"
+#include "valueTable.h"
+#include "../NumberText/numberText.h"
+
+/**
+ * Optimizer
+ * - Whole script optimizer. Runs after ConstantFolder when it's asked for (--optimize). Every change keeps what the script prints,
+ *   what it reads and the runtime error it stops on, if any.
+ * - A script is straight-line code with one-way ifs, so it's lowered to SSA in a single pass over the statements.
+ *   Every expression gets a value number (see ValueTable) and every store makes a new Definition of its variable.
+ *   A store under an if is the phi of its value and the Definition before it. The variable is opaque after it.
+ * - Done in the same pass:
+ *   - Constant propagation. A read of a variable whose value is known becomes a number, so "x := 5; output << x + 1;" prints a literal.
+ *     An if whose condition is known is removed, or replaced by its statement.
+ *   - Value numbering. An expression whose value a double variable already holds becomes a read of that variable.
+ *   - Dead stores. An assignment whose Definition is never read is removed. Its own reads only count if it stays,
+ *     so a chain of stores that only feed each other goes at once.
+ * - Left as they are: ifs whose statement is another if or a declaration, string comparisons and whiles. Their reads keep every Definition
+ *   they might see and their stores make the variable opaque. A while is never looked into: its body may run any number of times,
+ *   so nothing known before it holds in it, and nothing is known of what it stores after it. What it declares is removed again by the
+ *   end of every iteration, so a variable is as declared after it as before it. Stores that may stop on a runtime error (a string in the expression,
+ *   a variable that isn't declared yet, a value an integer variable can't hold) are never removed.
+ * - Statements are walked from their root into a post-order list, since the passes before may have added nodes anywhere.
+**/
+class Optimizer{
+
+private:
+    using LanguageToken = LanguageDictionary::LanguageToken;
+    using NodeIndex = CompactTree::NodeIndex;
+    using ValueId = ValueTable::ValueId;
+    using Slot = uint32_t;
+
+    static constexpr uint32_t NoDefinition = UINT32_MAX;
+    static constexpr uint32_t NoStatement = UINT32_MAX;
+    static constexpr uint32_t NoPosition = UINT32_MAX;
+
+    // What is in the subtree of a node
+    enum NodeFlags : uint8_t{
+        MayThrow    = 1 << 0,                                               // The interpreter may stop on an error in it
+        HasRead     = 1 << 1                                                // Reads a variable
+    };
+
+    struct Variable{
+        LanguageToken   _type           = LanguageToken::InvalidToken;      // Of its declaration. InvalidToken while it isn't declared
+        ValueId         _value          = ValueTable::NoValue;              // What a read gives right now
+        uint32_t        _definition     = NoDefinition;                     // Latest Definition
+        NodeIndex       _name           = CompactTree::NullNode;            // An identifier node of the variable, for its spelling
+    };
+
+    // One version of a variable. Made by a declaration, an assignment or an input
+    struct Definition{
+        uint32_t        _previous;                                          // The version it may not have replaced, if it's conditional
+        uint32_t        _statement;                                         // Removed if it's never read. NoStatement if it has to stay
+        uint32_t        _firstRead      = 0;                                // Definitions its statement reads, in _reads
+        uint32_t        _readCount      = 0;
+        bool            _isConditional;                                     // Under an if
+        bool            _isLive         = false;                            // Read by something that stays
+    };
+
+private:
+    CompactTree&                        _trees;                             // The trees that are optimized
+    ValueTable                          _values;
+    std::vector<Variable>               _variables;                         // By slot
+    std::vector<Definition>             _definitions;                       // In the order the script makes them
+    std::vector<uint32_t>               _reads;                             // Definitions read by statements that may be removed
+    std::unordered_map<ValueId, Slot>   _holders;                           // A double variable that holds the value right now
+
+    // The statement being lowered, in post-order
+    std::vector<NodeIndex>              _order;
+    std::vector<uint32_t>               _sizes;                             // Nodes in the subtree
+    std::vector<ValueId>                _nodeValues;                        // NoValue if it isn't a number
+    std::vector<uint8_t>                _flags;                             // NodeFlags of the subtree
+    std::vector<uint32_t>               _statementReads;                    // Latest Definition of every variable the statement reads
+    std::vector<std::pair<NodeIndex, bool>> _pending;                       // Walk of a tree. The bool is set once the children are done
+
+    std::size_t                         _removedStatementCount  = 0;
+    std::size_t                         _removedOperationCount  = 0;
+    std::size_t                         _propagatedCount        = 0;        // Expressions with a read replaced by their value
+    std::size_t                         _reusedCount            = 0;        // Expressions replaced by a variable that holds their value
+    std::size_t                         _decidedCount           = 0;        // Ifs whose condition was known
+
+// Constructors
+public:
+    Optimizer(CompactTree& trees) : _trees(trees){}
+
+    Optimizer(Optimizer const&) = delete;
+    void operator=(Optimizer const&) = delete;
+
+// Methods
+public:
+    void run(){
+        std::size_t operationCount = countOperations();
+        _variables.assign(_trees.getSlotCount(), Variable());
+        for(std::size_t i = 0; i < _trees.getStatementCount(); ++i){
+            lowerStatement((uint32_t)i);
+        }
+        removeDeadStores();
+        _removedOperationCount = operationCount - countOperations();
+
+        std::vector<Variable>().swap(_variables);
+        std::vector<Definition>().swap(_definitions);
+        std::vector<uint32_t>().swap(_reads);
+        std::unordered_map<ValueId, Slot>().swap(_holders);
+    }
+
+    std::size_t getRemovedStatementCount() const{
+        return _removedStatementCount;
+    }
+
+    std::size_t getRemovedOperationCount() const{
+        return _removedOperationCount;
+    }
+
+    std::size_t getPropagatedCount() const{
+        return _propagatedCount;
+    }
+
+    std::size_t getReusedCount() const{
+        return _reusedCount;
+    }
+
+    std::size_t getDecidedCount() const{
+        return _decidedCount;
+    }
+
+private:
+    void lowerStatement(uint32_t statement){
+        NodeIndex root = _trees.getRoot(statement);
+        if(root == CompactTree::NullNode){
+            return;
+        }
+        lower(root);
+        _statementReads.clear();
+
+        uint32_t top = (uint32_t)_order.size() - 1;
+        uint32_t definition = NoDefinition;
+        NodeIndex newRoot = root;
+        switch(_trees.getToken(root)){
+            case LanguageToken::TypeIntegerToken:
+            case LanguageToken::TypeDoubleToken:
+            case LanguageToken::TypeStringToken:
+                declare(top);
+                break;
+            case LanguageToken::AssignmentToken:
+                newRoot = assign(top, false, statement, definition);
+                break;
+            case LanguageToken::LeftShiftToken:
+                newRoot = output(top);
+                break;
+            case LanguageToken::RightShiftToken:
+                input(top, false);
+                break;
+            case LanguageToken::IfToken:
+                newRoot = branch(top, statement, definition);
+                break;
+            case LanguageToken::WhileToken:
+                keep(top);
+                break;
+            default:
+                keep(top);
+                break;
+        }
+
+        // The reads of a store that may be removed only count once it's known to stay
+        if(definition != NoDefinition && _definitions[definition]._statement != NoStatement){
+            _definitions[definition]._firstRead = (uint32_t)_reads.size();
+            _definitions[definition]._readCount = (uint32_t)_statementReads.size();
+            _reads.insert(_reads.end(), _statementReads.begin(), _statementReads.end());
+        }else{
+            for(uint32_t read : _statementReads){
+                markLive(read);
+            }
+        }
+
+        if(newRoot != root){
+            if(newRoot == CompactTree::NullNode){
+                ++_removedStatementCount;
+            }
+            _trees.setRoot(statement, newRoot);
+        }
+    }
+
+    // The tree into _order, children before their parent, with the value of every node
+    void lower(NodeIndex root){
+        _order.clear();
+        _sizes.clear();
+        _nodeValues.clear();
+        _flags.clear();
+        _pending.push_back({root, false});
+        while(!_pending.empty()){
+            auto [node, isExpanded] = _pending.back();
+            _pending.pop_back();
+            if(!isExpanded){
+                _pending.push_back({node, true});
+                if(_trees.getRight(node) != CompactTree::NullNode){
+                    _pending.push_back({_trees.getRight(node), false});
+                }
+                if(_trees.getLeft(node) != CompactTree::NullNode){
+                    _pending.push_back({_trees.getLeft(node), false});
+                }
+                continue;
+            }
+
+            uint32_t position = (uint32_t)_order.size();
+            _order.push_back(node);
+            uint32_t left = leftOf(position);
+            uint32_t right = rightOf(position);
+            _sizes.push_back(1 + (left != NoPosition ? _sizes[left] : 0) + (right != NoPosition ? _sizes[right] : 0));
+
+            ValueId value = ValueTable::NoValue;
+            uint8_t flags = (left != NoPosition ? _flags[left] : 0) | (right != NoPosition ? _flags[right] : 0);
+            bool mayThrow = false;
+            switch(_trees.getToken(node)){
+                case LanguageToken::NumberIntegerToken:
+                    value = _values.constant((double)_trees.getNumber(node)._integer);
+                    break;
+                case LanguageToken::NumberToken:
+                case LanguageToken::NumberDoubleToken:
+                    value = _values.constant(_trees.getNumber(node)._double);
+                    break;
+                case LanguageToken::IdentifierToken:
+                    value = readValue(_trees.getSlot(node), mayThrow);
+                    flags |= HasRead;
+                    break;
+                case LanguageToken::StringToken:
+                    value = _values.opaque(false);
+                    mayThrow = true;                                        // Only an error in an expression. Output and conditions check the token
+                    break;
+                case LanguageToken::AdditionToken:
+                case LanguageToken::SubtractionToken:
+                case LanguageToken::MultiplicationToken:
+                case LanguageToken::DivisionToken:
+                    {
+                        ValueId lhs = valueAt(left);
+                        ValueId rhs = valueAt(right);
+                        if(lhs == ValueTable::NoValue || rhs == ValueTable::NoValue){
+                            value = _values.opaque(false);
+                            mayThrow = true;
+                        }else{
+                            value = _values.operation(_trees.getToken(node), lhs, rhs);
+                        }
+                    }
+                    break;
+                default:
+                    break;
+            }
+            _nodeValues.push_back(value);
+            _flags.push_back(flags | (mayThrow ? MayThrow : 0));
+        }
+    }
+
+    // What a read of the variable gives before the statement runs
+    ValueId readValue(Slot slot, bool& mayThrow){
+        const Variable& variable = _variables[slot];
+        switch(variable._type){
+            case LanguageToken::TypeIntegerToken:
+            case LanguageToken::TypeDoubleToken:
+                return variable._value;
+            case LanguageToken::TypeStringToken:
+                return ValueTable::NoValue;                                 // Strings are compared as text
+            default:
+                mayThrow = true;                                            // Not declared
+                return _values.opaque(false);
+        }
+    }
+
+// Statements
+private:
+    void declare(uint32_t position){
+        NodeIndex node = _order[position];
+        NodeIndex name = _trees.getLeft(_trees.getLeft(node));
+        Slot slot = _trees.getSlot(name);
+        Variable& variable = _variables[slot];
+        variable._type = _trees.getToken(node);
+        variable._name = name;
+        addDefinition(slot, false, NoStatement);
+        setValue(slot, variable._type == LanguageToken::TypeStringToken ? ValueTable::NoValue : _values.constant(0.0));
+    }
+
+    // `statement` is where the store is removed from if it's dead. NoStatement if it can't be
+    NodeIndex assign(uint32_t position, bool isConditional, uint32_t statement, uint32_t& definition){
+        NodeIndex node = _order[position];
+        uint32_t right = rightOf(position);
+        NodeIndex rhs = right != NoPosition ? rewriteValue(right) : CompactTree::NullNode;
+        ValueId value = valueAt(right);
+
+        Slot slot = _trees.getSlot(_trees.getLeft(node));
+        LanguageToken type = _variables[slot]._type;
+        bool isRemovable = statement != NoStatement && type != LanguageToken::InvalidToken && !(right != NoPosition && canThrow(right))
+            && !(type == LanguageToken::TypeIntegerToken && !_values.isIntegral(value));
+        definition = addDefinition(slot, isConditional, isRemovable ? statement : NoStatement);
+        if(isConditional){
+            setValue(slot, type == LanguageToken::TypeStringToken ? ValueTable::NoValue : _values.opaque(type == LanguageToken::TypeIntegerToken));
+        }else if(type == LanguageToken::TypeIntegerToken){
+            setValue(slot, _values.truncation(value));
+        }else if(type == LanguageToken::TypeDoubleToken){
+            setValue(slot, value);
+        }else{
+            setValue(slot, ValueTable::NoValue);
+        }
+
+        if(rhs == _trees.getRight(node)){
+            return node;
+        }
+        return _trees.copyNode(node, _trees.getLeft(node), rhs);
+    }
+
+    // A known value is printed as a constant. An integer as its text, computed here once. A double as a number, the
+    // format it's printed in is only known when it runs (see StandardOutput)
+    NodeIndex output(uint32_t position){
+        NodeIndex node = _order[position];
+        uint32_t right = rightOf(position);
+        if(right == NoPosition){
+            return node;
+        }
+        NodeIndex rhs = _order[right];
+        NodeIndex printed = rhs;
+        switch(_trees.getToken(rhs)){
+            case LanguageToken::StringToken:
+            case LanguageToken::LiteralToken:
+                break;
+            case LanguageToken::IdentifierToken:
+                {
+                    // Printed by the type of the variable
+                    Slot slot = _trees.getSlot(rhs);
+                    const Variable& variable = _variables[slot];
+                    bool isKnown = variable._value != ValueTable::NoValue && _values.isConstant(variable._value);
+                    if(isKnown && variable._type == LanguageToken::TypeIntegerToken){
+                        printed = addText(NumberText::toString((int64_t)(int)_values.getNumber(variable._value)), rhs);
+                        ++_propagatedCount;
+                    }else if(isKnown && variable._type == LanguageToken::TypeDoubleToken){
+                        printed = _trees.addNumber(_values.getNumber(variable._value), _trees.getColumn(rhs));
+                        ++_propagatedCount;
+                    }else{
+                        read(slot);
+                    }
+                }
+                break;
+            default:
+                {
+                    // Printed as a double
+                    ValueId value = _nodeValues[right];
+                    if(value != ValueTable::NoValue && _values.isConstant(value) && !canThrow(right)){
+                        printed = _trees.addNumber(_values.getNumber(value), _trees.getColumn(rhs));
+                        _propagatedCount += hasRead(right);
+                    }else{
+                        printed = rewriteValue(right);
+                    }
+                }
+                break;
+        }
+
+        if(printed == rhs){
+            return node;
+        }
+        return _trees.copyNode(node, _trees.getLeft(node), printed);
+    }
+
+    void input(uint32_t position, bool isConditional){
+        NodeIndex node = _order[position];
+        Slot slot = _trees.getSlot(_trees.getRight(node));
+        LanguageToken type = _variables[slot]._type;
+        addDefinition(slot, isConditional, NoStatement);
+        setValue(slot, type == LanguageToken::TypeStringToken ? ValueTable::NoValue : _values.opaque(type == LanguageToken::TypeIntegerToken));
+    }
+
+    // One-way if. The statement under it runs once if the condition holds
+    NodeIndex branch(uint32_t position, uint32_t statement, uint32_t& definition){
+        NodeIndex node = _order[position];
+        uint32_t conditionPosition = leftOf(position);
+        uint32_t bodyPosition = rightOf(position);
+        if(conditionPosition == NoPosition || bodyPosition == NoPosition){
+            keep(position);
+            return node;
+        }
+
+        // Only numeric comparisons and simple statements are lowered. Strings have no value
+        NodeIndex condition = _order[conditionPosition];
+        LanguageToken body = _trees.getToken(_order[bodyPosition]);
+        uint32_t lhs = leftOf(conditionPosition);
+        uint32_t rhs = rightOf(conditionPosition);
+        ValueId lhsValue = valueAt(lhs);
+        ValueId rhsValue = valueAt(rhs);
+        bool isComparison = isComparisonToken(_trees.getToken(condition)) && lhsValue != ValueTable::NoValue && rhsValue != ValueTable::NoValue
+            && _trees.getToken(_trees.getLeft(condition)) != LanguageToken::StringToken
+            && _trees.getToken(_trees.getRight(condition)) != LanguageToken::StringToken;
+        bool isSimple = body == LanguageToken::AssignmentToken || body == LanguageToken::LeftShiftToken || body == LanguageToken::RightShiftToken;
+        if(!isComparison || !isSimple){
+            keep(position);
+            return node;
+        }
+
+        bool mayThrow = (lhs != NoPosition && canThrow(lhs)) || (rhs != NoPosition && canThrow(rhs));
+        if(!mayThrow && _values.isConstant(lhsValue) && _values.isConstant(rhsValue)){
+            ++_decidedCount;
+            if(!compare(_trees.getToken(condition), _values.getNumber(lhsValue), _values.getNumber(rhsValue))){
+                return CompactTree::NullNode;
+            }
+            return lowerBody(bodyPosition, false, statement, definition);
+        }
+
+        NodeIndex newLhs = lhs != NoPosition ? rewriteValue(lhs) : CompactTree::NullNode;
+        NodeIndex newRhs = rhs != NoPosition ? rewriteValue(rhs) : CompactTree::NullNode;
+        NodeIndex newCondition = condition;
+        if(newLhs != _trees.getLeft(condition) || newRhs != _trees.getRight(condition)){
+            newCondition = _trees.copyNode(condition, newLhs, newRhs);
+        }
+
+        // Removing the store removes the whole if, which is only fine if the condition can't stop the script
+        NodeIndex newBody = lowerBody(bodyPosition, true, mayThrow ? NoStatement : statement, definition);
+        if(newCondition == condition && newBody == _order[bodyPosition]){
+            return node;
+        }
+        return _trees.copyNode(node, newCondition, newBody);
+    }
+
+    NodeIndex lowerBody(uint32_t position, bool isConditional, uint32_t statement, uint32_t& definition){
+        switch(_trees.getToken(_order[position])){
+            case LanguageToken::AssignmentToken:
+                return assign(position, isConditional, statement, definition);
+            case LanguageToken::LeftShiftToken:
+                return output(position);
+            default:
+                input(position, isConditional);
+                return _order[position];
+        }
+    }
+
+    // A statement that isn't lowered. Everything it reads is live and everything it stores is opaque after it
+    void keep(uint32_t top){
+        std::vector<Slot> stores;
+        for(uint32_t position = 0; position <= top; ++position){
+            NodeIndex node = _order[position];
+            switch(_trees.getToken(node)){
+                case LanguageToken::AssignmentToken:
+                    stores.push_back(_trees.getSlot(_trees.getLeft(node)));
+                    break;
+                case LanguageToken::RightShiftToken:
+                    stores.push_back(_trees.getSlot(_trees.getRight(node)));
+                    break;
+                case LanguageToken::IdentifierToken:
+                    read(_trees.getSlot(node));                             // Also the targets. Reading too much only keeps more
+                    break;
+                default:
+                    break;
+            }
+        }
+        for(Slot slot : stores){
+            LanguageToken type = _variables[slot]._type;
+            addDefinition(slot, true, NoStatement);
+            setValue(slot, type == LanguageToken::TypeStringToken ? ValueTable::NoValue : _values.opaque(type == LanguageToken::TypeIntegerToken));
+        }
+    }
+
+// Expressions
+private:
+
+    // Same value, computed with less. Only called on the operands of numbers, never on what "output" prints as it is
+    NodeIndex rewriteValue(uint32_t position){
+        NodeIndex node = _order[position];
+        LanguageToken token = _trees.getToken(node);
+        ValueId value = _nodeValues[position];
+        if(token == LanguageToken::NumberIntegerToken || token == LanguageToken::NumberDoubleToken || token == LanguageToken::NumberToken){
+            return node;
+        }
+        if(value != ValueTable::NoValue && _values.isConstant(value) && !canThrow(position)){
+            _propagatedCount += hasRead(position);
+            return _trees.addNumber(_values.getNumber(value), _trees.getColumn(node));
+        }
+        if(token == LanguageToken::IdentifierToken){
+            read(_trees.getSlot(node));
+            return node;
+        }
+        if(!isArithmetic(token)){
+            return node;
+        }
+
+        // Already in a variable
+        if(!canThrow(position)){
+            auto holder = _holders.find(value);
+            if(holder != _holders.end()){
+                ++_reusedCount;
+                read(holder->second);
+                std::string_view name = _trees.getValue(_variables[holder->second]._name);
+                return _trees.addNode(LanguageToken::IdentifierToken, CompactTree::NullNode, CompactTree::NullNode, name, {0}, _trees.getColumn(node));
+            }
+        }
+
+        uint32_t left = leftOf(position);
+        uint32_t right = rightOf(position);
+        NodeIndex lhs = left != NoPosition ? rewriteValue(left) : CompactTree::NullNode;
+        NodeIndex rhs = right != NoPosition ? rewriteValue(right) : CompactTree::NullNode;
+        if(lhs == _trees.getLeft(node) && rhs == _trees.getRight(node)){
+            return node;
+        }
+        return _trees.copyNode(node, lhs, rhs);
+    }
+
+    bool canThrow(uint32_t position) const{
+        return (_flags[position] & MayThrow) != 0;
+    }
+
+    bool hasRead(uint32_t position) const{
+        return (_flags[position] & HasRead) != 0;
+    }
+
+    // A missing operand counts as 0, like in the interpreter
+    ValueId valueAt(uint32_t position){
+        return position != NoPosition ? _nodeValues[position] : _values.constant(0.0);
+    }
+
+    // Children come right before their parent in _order, the right one last
+    uint32_t rightOf(uint32_t position) const{
+        return _trees.getRight(_order[position]) != CompactTree::NullNode ? position - 1 : NoPosition;
+    }
+
+    uint32_t leftOf(uint32_t position) const{
+        if(_trees.getLeft(_order[position]) == CompactTree::NullNode){
+            return NoPosition;
+        }
+        return _trees.getRight(_order[position]) != CompactTree::NullNode ? position - 1 - _sizes[position - 1] : position - 1;
+    }
+
+// Definitions
+private:
+    uint32_t addDefinition(Slot slot, bool isConditional, uint32_t statement){
+        Definition definition;
+        definition._previous = _variables[slot]._definition;
+        definition._statement = statement;
+        definition._isConditional = isConditional;
+        _definitions.push_back(definition);
+        _variables[slot]._definition = (uint32_t)(_definitions.size() - 1);
+        return _variables[slot]._definition;
+    }
+
+    void setValue(Slot slot, ValueId value){
+        Variable& variable = _variables[slot];
+        auto holder = _holders.find(variable._value);
+        if(holder != _holders.end() && holder->second == slot){
+            _holders.erase(holder);
+        }
+        variable._value = value;
+        if(variable._type == LanguageToken::TypeDoubleToken && value != ValueTable::NoValue && !_values.isConstant(value)){
+            _holders[value] = slot;
+        }
+    }
+
+    void read(Slot slot){
+        if(_variables[slot]._definition != NoDefinition){
+            _statementReads.push_back(_variables[slot]._definition);
+        }
+    }
+
+    /**
+     * The Definition and every one it may not have replaced are live.
+     * - A live Definition already had the ones before it marked, so the walk stops there. Every Definition is marked once.
+    **/
+    void markLive(uint32_t definition){
+        while(definition != NoDefinition && !_definitions[definition]._isLive){
+            _definitions[definition]._isLive = true;
+            if(!_definitions[definition]._isConditional){
+                break;
+            }
+            definition = _definitions[definition]._previous;
+        }
+    }
+
+    // Last to first, so a statement's reads are marked before the Definitions they read are looked at
+    void removeDeadStores(){
+        for(std::size_t i = _definitions.size(); i-- > 0;){
+            const Definition& definition = _definitions[i];
+            if(definition._isLive){
+                for(uint32_t read = 0; read < definition._readCount; ++read){
+                    markLive(_reads[definition._firstRead + read]);
+                }
+            }else if(definition._statement != NoStatement && _trees.getRoot(definition._statement) != CompactTree::NullNode){
+                _trees.setRoot(definition._statement, CompactTree::NullNode);
+                ++_removedStatementCount;
+            }
+        }
+    }
+
+// Others
+private:
+    NodeIndex addText(const std::string& text, NodeIndex node){
+        return _trees.addNode(LanguageToken::LiteralToken, CompactTree::NullNode, CompactTree::NullNode, text, {0}, _trees.getColumn(node));
+    }
+
+    static bool compare(LanguageToken token, double lhs, double rhs){
+        switch(token){
+            case LanguageToken::LessThanToken:      return lhs < rhs;
+            case LanguageToken::GreaterThanToken:   return lhs > rhs;
+            case LanguageToken::EqualityToken:      return lhs == rhs;
+            default:                                return lhs != rhs;
+        }
+    }
+
+    static bool isComparisonToken(LanguageToken token){
+        return token == LanguageToken::LessThanToken || token == LanguageToken::GreaterThanToken
+            || token == LanguageToken::EqualityToken || token == LanguageToken::NotEqualToken;
+    }
+
+    static bool isArithmetic(LanguageToken token){
+        return token == LanguageToken::AdditionToken || token == LanguageToken::SubtractionToken
+            || token == LanguageToken::MultiplicationToken || token == LanguageToken::DivisionToken;
+    }
+
+    // Operations still reachable from a statement
+    std::size_t countOperations(){
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < _trees.getStatementCount(); ++i){
+            if(_trees.getRoot(i) != CompactTree::NullNode){
+                _pending.push_back({_trees.getRoot(i), false});
+            }
+            while(!_pending.empty()){
+                NodeIndex node = _pending.back().first;
+                _pending.pop_back();
+                count += isArithmetic(_trees.getToken(node));
+                if(_trees.getLeft(node) != CompactTree::NullNode){
+                    _pending.push_back({_trees.getLeft(node), false});
+                }
+                if(_trees.getRight(node) != CompactTree::NullNode){
+                    _pending.push_back({_trees.getRight(node), false});
+                }
+            }
+        }
+        return count;
+    }
+};
+
+#endif // OPTIMIZER_H
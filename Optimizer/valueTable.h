@@ -0,0 +1,213 @@
+#ifndef VALUETABLE_H
+#define VALUETABLE_H
+
+// Standard Libraries
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Created Classes
+#include "../LanguageDictionary/LanguageDictionary.h"
+
+/**
+ * Value Table
+ * - The values of the optimizer's IR. A value is defined once and never changes, so two expressions with the same value number
+ *   compute the same double, wherever they are in the script.
+ * - Values are numbered by what they are computed from (value numbering). Asking twice for "a + b" with the same a and b gives
+ *   the same number, the second time without adding anything.
+ * - An operation on two constants is folded, and the identities that hold for every double ("x * 1", "1 * x", "x / 1" and
+ *   "x - 0") give x back. Same rules as ConstantFolder, so a division by zero and a result that isn't finite stay operations.
+ * - An opaque value is one that can't be known before running, e.g. what "input" read. Every opaque value is different from every other.
+**/
+class ValueTable{
+
+public:
+    using LanguageToken = LanguageDictionary::LanguageToken;
+    using ValueId = uint32_t;
+    static constexpr ValueId NoValue = UINT32_MAX;
+
+    enum class Kind : uint8_t{
+        Constant,                                                           // _number
+        Operation,                                                          // _operation of _left and _right
+        Truncation,                                                         // _left stored in an integer variable
+        Opaque                                                              // Only known when the script runs
+    };
+
+private:
+    struct Value{
+        double          _number     = 0.0;
+        ValueId         _left       = NoValue;
+        ValueId         _right      = NoValue;
+        Kind            _kind       = Kind::Opaque;
+        uint8_t         _operation  = 0;                                    // LanguageToken of an Operation
+        bool            _isIntegral = false;                                // Always a whole number in the range of an int
+    };
+
+    static constexpr ValueId EmptyBucket = UINT32_MAX;
+
+private:
+    std::vector<Value>      _values;
+    std::vector<ValueId>    _buckets;                                       // Open addressing. Every value but the opaque ones
+    std::size_t             _hashedCount    = 0;
+
+// Constructors
+public:
+    ValueTable() : _buckets(1024, EmptyBucket){}
+
+    ValueTable(ValueTable const&) = delete;
+    void operator=(ValueTable const&) = delete;
+
+// Methods
+public:
+    ValueId constant(double number){
+        Value value;
+        value._kind = Kind::Constant;
+        value._number = number;
+        value._isIntegral = number == std::trunc(number) && number > -2147483649.0 && number < 2147483648.0
+            && !(number == 0.0 && std::signbit(number));                    // An integer variable holds -0 as 0
+        return find(value);
+    }
+
+    // `operation` is one of + - * /
+    ValueId operation(LanguageToken operation, ValueId left, ValueId right){
+        if(isConstant(left) && isConstant(right)){
+            double number = 0.0;
+            if(fold(operation, _values[left]._number, _values[right]._number, number)){
+                return constant(number);
+            }
+        }
+        if(operation == LanguageToken::MultiplicationToken && isConstantOf(left, 1.0)){
+            return right;
+        }
+        if((operation == LanguageToken::MultiplicationToken || operation == LanguageToken::DivisionToken) && isConstantOf(right, 1.0)){
+            return left;
+        }
+        if(operation == LanguageToken::SubtractionToken && isConstantOf(right, 0.0) && !std::signbit(_values[right]._number)){
+            return left;
+        }
+
+        Value value;
+        value._kind = Kind::Operation;
+        value._operation = (uint8_t)operation;
+        value._left = left;
+        value._right = right;
+        return find(value);
+    }
+
+    // What an integer variable holds once `value` is assigned to it. Left to the interpreter if it doesn't fit in an int
+    ValueId truncation(ValueId value){
+        if(_values[value]._isIntegral){
+            return value;
+        }
+        if(isConstant(value)){
+            double number = _values[value]._number;
+            if(number > -2147483649.0 && number < 2147483648.0){
+                return constant((double)(int)number);
+            }
+        }
+        Value truncated;
+        truncated._kind = Kind::Truncation;
+        truncated._left = value;
+        truncated._isIntegral = true;
+        return find(truncated);
+    }
+
+    ValueId opaque(bool isIntegral){
+        Value value;
+        value._isIntegral = isIntegral;
+        _values.push_back(value);
+        return (ValueId)(_values.size() - 1);
+    }
+
+    // An integer variable can hold it as it is
+    bool isIntegral(ValueId value) const{
+        return value != NoValue && _values[value]._isIntegral;
+    }
+
+    bool isConstant(ValueId value) const{
+        return _values[value]._kind == Kind::Constant;
+    }
+
+    double getNumber(ValueId value) const{
+        return _values[value]._number;
+    }
+
+    std::size_t size() const{
+        return _values.size();
+    }
+
+private:
+    bool isConstantOf(ValueId value, double number) const{
+        return isConstant(value) && _values[value]._number == number;
+    }
+
+    // Same arithmetic as Interpreter::evaluateValue. False if the interpreter has to do it
+    static bool fold(LanguageToken operation, double lhs, double rhs, double& number){
+        switch(operation){
+            case LanguageToken::AdditionToken:          number = lhs + rhs; break;
+            case LanguageToken::SubtractionToken:       number = lhs - rhs; break;
+            case LanguageToken::MultiplicationToken:    number = lhs * rhs; break;
+            default:
+                if(rhs == 0.0){
+                    return false;
+                }
+                number = lhs / rhs;
+                break;
+        }
+        return std::isfinite(number);
+    }
+
+    // The number of the value, added if it's new
+    ValueId find(const Value& value){
+        std::size_t mask = _buckets.size() - 1;
+        std::size_t bucket = hash(value) & mask;
+        while(_buckets[bucket] != EmptyBucket){
+            if(isSame(_values[_buckets[bucket]], value)){
+                return _buckets[bucket];
+            }
+            bucket = (bucket + 1) & mask;
+        }
+        _values.push_back(value);
+        _buckets[bucket] = (ValueId)(_values.size() - 1);
+        if(++_hashedCount * 2 > _buckets.size()){
+            grow();
+        }
+        return (ValueId)(_values.size() - 1);
+    }
+
+    void grow(){
+        std::vector<ValueId> buckets(_buckets.size() * 2, EmptyBucket);
+        std::size_t mask = buckets.size() - 1;
+        for(ValueId id : _buckets){
+            if(id == EmptyBucket){
+                continue;
+            }
+            std::size_t bucket = hash(_values[id]) & mask;
+            while(buckets[bucket] != EmptyBucket){
+                bucket = (bucket + 1) & mask;
+            }
+            buckets[bucket] = id;
+        }
+        _buckets.swap(buckets);
+    }
+
+    // Constants are the same if their bits are, so 0 and -0 are two values
+    static bool isSame(const Value& a, const Value& b){
+        return a._kind == b._kind && a._operation == b._operation && a._left == b._left && a._right == b._right
+            && std::memcmp(&a._number, &b._number, sizeof(double)) == 0;
+    }
+
+    static std::size_t hash(const Value& value){
+        uint64_t bits;
+        std::memcpy(&bits, &value._number, sizeof(double));
+        uint64_t hash = bits ^ ((uint64_t)value._left << 32 | value._right) * 0x9E3779B97F4A7C15ull;
+        hash ^= (uint64_t)value._kind << 8 | value._operation;
+        hash ^= hash >> 29;
+        hash *= 0xBF58476D1CE4E5B9ull;
+        return (std::size_t)(hash ^ hash >> 32);
+    }
+};
+
+#endif // VALUETABLE_H
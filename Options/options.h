@@ -0,0 +1,190 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+// Standard Libraries
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// Created Classes
+#include "../NumberText/numberText.h"
+
+/**
+ * Options
+ * - Command line options of hlint.
+ * - The side files (NOSPACES.txt and RES_SYM.txt) cost memory and I/O, so they are only written when asked for.
+**/
+struct Options{
+
+    // How the symbol trace (every node visited by the syntax analyzer) is written
+    enum SymbolTraceFormat{
+        NoSymbolTrace,                                                      // Don't write it
+        TextSymbolTrace,                                                    // RES_SYM.txt. One "Token: value" line per node
+        BinarySymbolTrace                                                   // RES_SYM.bin. See AST::writeSymbolTrace for the layout
+    };
+
+    // What runs the script
+    enum Engine{
+        TreeEngine,                                                         // The trees, walked by the Interpreter. The reference
+        VirtualMachineEngine                                                // Compiled to bytecode, run by the VirtualMachine
+    };
+
+    // When the output of the script is written to stdout (see StandardOutput)
+    enum OutputBuffering{
+        AutoBuffering,                                                      // Line buffered if stdout is a terminal, fully buffered otherwise
+        LineBuffering,                                                      // After every line
+        FullBuffering                                                       // When the buffer is full, before an input from a terminal and at the end
+    };
+
+    std::string         _filename           = "test.txt";                   // The script to run
+    bool                _hasFilename        = false;                        // If the script was given on the command line
+    bool                _writeNoSpaces      = false;                        // Write NOSPACES.txt
+    SymbolTraceFormat   _symbolTrace        = NoSymbolTrace;                // Write RES_SYM.txt or RES_SYM.bin
+    unsigned            _threads            = 0;                            // Threads used for lexing and validation. 0 is one per core
+    bool                _watch              = false;                        // Check the script again every time it's saved
+    bool                _dumpTree           = false;                        // Write the trees before and after the optimizer to TREE.txt
+    bool                _optimize           = false;                        // Run the whole script optimizer after constant folding
+    Engine              _engine             = TreeEngine;                   // What runs the script
+    OutputBuffering     _outputBuffering    = AutoBuffering;                // When the output of the script is written
+    NumberText::Format  _doubleFormat       = NumberText::StreamFormat;     // How the script prints doubles
+    bool                _useImage           = true;                         // Run from the program image (.hlc) of the script if there is one, write it otherwise
+    std::string         _cacheDirectory     = "";                           // Where the program images go. Next to the script if empty
+    std::string         _inputFile          = "";                           // Where `input >>` reads from. stdin if empty
+    bool                _showHelp           = false;                        // Only print the usage
+
+    // Returns false if an option isn't known. The reason is already printed
+    static bool parse(int argc, char** argv, Options& options){
+        for(int i = 1; i < argc; ++i){
+            std::string argument = argv[i];
+
+            if(argument == "--nospaces"){
+                options._writeNoSpaces = true;
+            }
+            else if(argument == "--res-sym"){
+                options._symbolTrace = TextSymbolTrace;
+            }
+            else if(argument == "--res-sym-binary"){
+                options._symbolTrace = BinarySymbolTrace;
+            }
+            else if(argument == "--threads"){
+                if(i + 1 >= argc || !parseCount(argv[++i], options._threads)){
+                    std::cout << "[!] --threads expects a number" << std::endl;
+                    return false;
+                }
+            }
+            else if(argument == "--optimize" || argument == "-O"){
+                options._optimize = true;
+            }
+            else if(argument == "--engine"){
+                std::string engine = i + 1 < argc ? argv[++i] : "";
+                if(engine == "tree"){
+                    options._engine = TreeEngine;
+                }else if(engine == "vm"){
+                    options._engine = VirtualMachineEngine;
+                }else{
+                    std::cout << "[!] --engine expects tree or vm" << std::endl;
+                    return false;
+                }
+            }
+            else if(argument == "--output-buffering"){
+                std::string buffering = i + 1 < argc ? argv[++i] : "";
+                if(buffering == "auto"){
+                    options._outputBuffering = AutoBuffering;
+                }else if(buffering == "line"){
+                    options._outputBuffering = LineBuffering;
+                }else if(buffering == "full"){
+                    options._outputBuffering = FullBuffering;
+                }else{
+                    std::cout << "[!] --output-buffering expects auto, line or full" << std::endl;
+                    return false;
+                }
+            }
+            else if(argument == "--double-format"){
+                std::string format = i + 1 < argc ? argv[++i] : "";
+                if(format == "stream"){
+                    options._doubleFormat = NumberText::StreamFormat;
+                }else if(format == "shortest"){
+                    options._doubleFormat = NumberText::ShortestFormat;
+                }else{
+                    std::cout << "[!] --double-format expects stream or shortest" << std::endl;
+                    return false;
+                }
+            }
+            else if(argument == "--dump-tree"){
+                options._dumpTree = true;
+            }
+            else if(argument == "--watch"){
+                options._watch = true;
+            }
+            else if(argument == "--no-cache"){
+                options._useImage = false;
+            }
+            else if(argument == "--cache-dir"){
+                if(i + 1 >= argc || argv[i + 1][0] == '\0'){
+                    std::cout << "[!] --cache-dir expects a directory" << std::endl;
+                    return false;
+                }
+                options._cacheDirectory = argv[++i];
+            }
+            else if(argument == "--input-file"){
+                if(i + 1 >= argc || argv[i + 1][0] == '\0'){
+                    std::cout << "[!] --input-file expects a file" << std::endl;
+                    return false;
+                }
+                options._inputFile = argv[++i];
+            }
+            else if(argument == "--help" || argument == "-h"){
+                options._showHelp = true;
+            }
+
+            // "-" alone is stdin, anything else starting with '-' is an option we don't know
+            else if(argument.size() > 1 && argument[0] == '-'){
+                std::cout << "[!] Unknown option [" << argument << "]" << std::endl;
+                return false;
+            }
+            else if(options._hasFilename){
+                std::cout << "[!] Only one file can be run at a time. Got [" << options._filename << "] and [" << argument << "]" << std::endl;
+                return false;
+            }
+            else{
+                options._filename = argument;
+                options._hasFilename = true;
+            }
+        }
+        return true;
+    }
+
+    static void printUsage(){
+        std::cout << "Usage: hlint [options] [file]" << std::endl;
+        std::cout << "  file                Script to run. '-' reads it from stdin. Defaults to 'test.txt'" << std::endl;
+        std::cout << "  --nospaces          Write the script without whitespace to NOSPACES.txt" << std::endl;
+        std::cout << "  --res-sym           Write every node checked by the syntax analyzer to RES_SYM.txt" << std::endl;
+        std::cout << "  --res-sym-binary    Same as --res-sym but in a compact binary form, to RES_SYM.bin" << std::endl;
+        std::cout << "  -O, --optimize      Propagate constants, reuse computed values and remove dead stores over the whole script" << std::endl;
+        std::cout << "  --engine tree|vm    Walk the trees of the script with the interpreter (default) or run it as bytecode on the virtual machine" << std::endl;
+        std::cout << "  --output-buffering auto|line|full  Write the output of the script after every line, or only when the buffer is full. auto (default) is line if stdout is a terminal" << std::endl;
+        std::cout << "  --double-format stream|shortest  Print doubles with 6 significant digits like std::cout (default), or with the fewest digits that read back as the same value" << std::endl;
+        std::cout << "  --dump-tree         Write every statement tree before and after the optimizer to TREE.txt" << std::endl;
+        std::cout << "  --threads N         Lex and validate the script with N threads. 0 (default) uses one per core" << std::endl;
+        std::cout << "  --watch             Check the script again every time it's saved. Only the changed statements are rebuilt. Doesn't run it" << std::endl;
+        std::cout << "  --cache-dir DIR     Keep the compiled images of the scripts in DIR instead of next to them (<script>.hlc)" << std::endl;
+        std::cout << "  --no-cache          Always compile the script. Don't read or write its compiled image" << std::endl;
+        std::cout << "  --input-file FILE   Read the input of the script from FILE instead of stdin. The file is mapped" << std::endl;
+        std::cout << "  -h, --help          Show this message" << std::endl;
+    }
+
+private:
+    static bool parseCount(const std::string& text, unsigned& count){
+        if(text.empty() || text.find_first_not_of("0123456789") != std::string::npos){
+            return false;
+        }
+        try{
+            count = (unsigned)std::stoul(text);
+        }catch(const std::out_of_range&){
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif // OPTIONS_H
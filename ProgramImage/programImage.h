@@ -0,0 +1,460 @@
+#ifndef PROGRAMIMAGE_H
+#define PROGRAMIMAGE_H
+
+// Standard Libraries
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+// Created Classes
+#include "../AbstractSyntaxTree/CompactTree.h"
+#include "../BufferedWriter/bufferedWriter.h"
+#include "../LanguageDictionary/LanguageDictionary.h"
+#include "../SourceBuffer/sourceBuffer.h"
+
+/**
+ * Program Image (.hlc)
+ * - A script that went through the lexer, the parser and the validation without errors, saved as the arrays of its CompactTree.
+ *   A later run of the same script maps the image and goes straight to the interpreter.
+ * - The arrays are stored exactly as they are in memory, 8 byte aligned, at offsets from the start of the file. Nothing in it is a pointer,
+ *   so the mapping can be anywhere and the tree reads it in place. Only the spelling table is built on load, one entry per distinct spelling.
+ * - An image is only used for the source it was made from (same size and hash) and by the same Version of hlint.
+ *   It's written next to the script as "<script>.hlc", or as "<hash>.hlc" in a cache directory.
+ * - The header keeps a checksum of itself and the sections, so an image damaged on disk is noticed before any of it is used.
+ * - The structure is checked once on load: every index has to be in range, children come before their parent and the nodes the
+ *   interpreter takes a slot from are identifiers. An image that fails a check is rebuilt, so a damaged one can't make the interpreter
+ *   read outside of it.
+ *
+ * Layout: Header, then the sections it points to.
+ *   tokens         uint8       per node
+ *   types          uint8       per node. CompactTree::ValueType, set by TypeChecker
+ *   left, right    uint32      per node
+ *   spellings      uint32      per node. Index into the spelling sections
+ *   columns        uint32      per node
+ *   numbers        int64/double per spelling
+ *   slots          uint32      per spelling. CompactTree::NoSlot if it isn't an identifier
+ *   spans          uint32 pair per spelling. Offset and length in text
+ *   text           bytes
+ *   statements     uint32 pair per statement. Root and line
+ *   bodies         uint32 pair per statement of a while body. Root and lines after its while
+**/
+class ProgramImage{
+
+public:
+    // Bump it whenever the parser, the validation or the layout of the tree changes. Older images are then rebuilt
+    static constexpr uint32_t Version = 9;
+
+private:
+    static constexpr char Magic[4] = {'H', 'L', 'C', 'I'};
+    static constexpr uint32_t ByteOrder = 0x01020304;                      // Reads differently on a machine of the other endianness
+    static constexpr uint64_t Alignment = 8;                                // Of every section
+    static constexpr std::size_t SectionCount = 12;
+
+    struct Section{
+        uint64_t    _offset;                                                // From the start of the image
+        uint64_t    _size;                                                  // In bytes
+    };
+
+    struct Header{
+        char        _magic[4];
+        uint32_t    _version;                                               // Version of hlint that wrote it
+        uint32_t    _byteOrder;                                             // ByteOrder as it was written
+        uint32_t    _slotCount;                                             // Distinct identifiers
+        uint64_t    _sourceSize;                                            // Bytes of the script
+        uint64_t    _sourceHash;                                            // hashSource() of the script
+        uint64_t    _checksum;                                              // checksumOf() the header and every section
+        uint64_t    _nodeCount;                                             // Including the null node
+        uint64_t    _spellingCount;
+        uint64_t    _statementCount;
+        uint64_t    _bodyStatementCount;
+        Section     _tokens;
+        Section     _types;
+        Section     _left;
+        Section     _right;
+        Section     _spellings;
+        Section     _columns;
+        Section     _numbers;
+        Section     _slots;
+        Section     _spans;
+        Section     _text;
+        Section     _statements;
+        Section     _bodyStatements;
+    };
+
+    struct Span{
+        uint32_t    _offset;                                                // Of the first byte in the text section
+        uint32_t    _length;
+    };
+
+    static_assert(sizeof(Header) % Alignment == 0, "Sections right after the header have to be aligned");
+    static_assert(sizeof(NumericValue) == 8 && sizeof(CompactTree::Statement) == 8, "The sections are written as they are in memory");
+
+// Constructors
+private:
+    ProgramImage(){}
+
+// Methods
+public:
+
+    // 64 bit hash of the script. Reads 8 bytes at a time, a million statement script takes a few milliseconds.
+    // An optimized image (--optimize) is another image of the same script
+    static uint64_t hashSource(const char* begin, const char* end, bool isOptimized = false){
+        uint64_t hash = 0x9E3779B97F4A7C15ull ^ (uint64_t)(end - begin);
+        while(end - begin >= 8){
+            uint64_t word;
+            std::memcpy(&word, begin, 8);
+            hash = mix(hash ^ word);
+            begin += 8;
+        }
+        uint64_t tail = 0;
+        if(end > begin){
+            std::memcpy(&tail, begin, (std::size_t)(end - begin));
+        }
+        return mix(mix(hash ^ tail) ^ Version ^ (isOptimized ? 1ull << 32 : 0));
+    }
+
+    // Where the image of a script is kept
+    static std::string pathFor(const std::string& script, const std::string& cacheDirectory, uint64_t sourceHash, bool isOptimized = false){
+        if(cacheDirectory.empty()){
+            return script + (isOptimized ? ".opt.hlc" : ".hlc");
+        }
+        char name[21];
+        std::snprintf(name, sizeof(name), "%016llx.hlc", (unsigned long long)sourceHash);
+        return cacheDirectory + (cacheDirectory.back() == '/' ? "" : "/") + name;
+    }
+
+    /**
+     * Writes the tree to `path`. Returns false if it couldn't be written, which only means the next run has to compile again.
+     * - Written to a temporary file first and renamed, so a run never maps a half written image.
+    **/
+    static bool save(const std::string& path, const CompactTree& trees, uint64_t sourceHash, uint64_t sourceSize){
+        const CompactTree::Arrays& arrays = trees.getArrays();
+
+        // The text of every spelling, one after another
+        std::vector<Span> spans(arrays._spellingCount);
+        std::string text;
+        for(std::size_t i = 0; i < arrays._spellingCount; ++i){
+            spans[i] = {(uint32_t)text.size(), (uint32_t)arrays._spellingTable[i].size()};
+            text += arrays._spellingTable[i];
+            if(text.size() > UINT32_MAX){
+                return false;
+            }
+        }
+        uint64_t textSize = text.size();
+
+        Header header{};
+        std::memcpy(header._magic, Magic, sizeof(Magic));
+        header._version = Version;
+        header._byteOrder = ByteOrder;
+        header._slotCount = (uint32_t)arrays._slotCount;
+        header._sourceSize = sourceSize;
+        header._sourceHash = sourceHash;
+        header._nodeCount = arrays._nodeCount;
+        header._spellingCount = arrays._spellingCount;
+        header._statementCount = arrays._statementCount;
+        header._bodyStatementCount = arrays._bodyStatementCount;
+
+        uint64_t offset = sizeof(Header);
+        header._tokens      = place(offset, arrays._nodeCount * sizeof(uint8_t));
+        header._types       = place(offset, arrays._nodeCount * sizeof(CompactTree::ValueType));
+        header._left        = place(offset, arrays._nodeCount * sizeof(CompactTree::NodeIndex));
+        header._right       = place(offset, arrays._nodeCount * sizeof(CompactTree::NodeIndex));
+        header._spellings   = place(offset, arrays._nodeCount * sizeof(uint32_t));
+        header._columns     = place(offset, arrays._nodeCount * sizeof(uint32_t));
+        header._numbers     = place(offset, arrays._spellingCount * sizeof(NumericValue));
+        header._slots       = place(offset, arrays._spellingCount * sizeof(uint32_t));
+        header._spans       = place(offset, arrays._spellingCount * sizeof(Span));
+        header._text        = place(offset, textSize);
+        header._statements  = place(offset, arrays._statementCount * sizeof(CompactTree::Statement));
+        header._bodyStatements = place(offset, arrays._bodyStatementCount * sizeof(CompactTree::Statement));
+
+        const void* sections[] = {arrays._tokens, arrays._types, arrays._left, arrays._right, arrays._spellings, arrays._columns,
+                                  arrays._spellingNumbers, arrays._spellingSlots, spans.data(), text.data(), arrays._statements, arrays._bodyStatements};
+        header._checksum = checksumOf(header, sections);
+
+        // Tried first, so that a directory that can't be written doesn't make the writer complain on every run
+        std::string temporary = path + ".tmp" + std::to_string(processId());
+        std::FILE* probe = std::fopen(temporary.c_str(), "wb");
+        if(probe == nullptr){
+            return false;
+        }
+        std::fclose(probe);
+        {
+            BufferedWriter writer(temporary);
+            if(!writer.isGood()){
+                return false;
+            }
+            uint64_t written = 0;
+            write(writer, written, {0, sizeof(Header)}, &header);
+            write(writer, written, header._tokens, arrays._tokens);
+            write(writer, written, header._types, arrays._types);
+            write(writer, written, header._left, arrays._left);
+            write(writer, written, header._right, arrays._right);
+            write(writer, written, header._spellings, arrays._spellings);
+            write(writer, written, header._columns, arrays._columns);
+            write(writer, written, header._numbers, arrays._spellingNumbers);
+            write(writer, written, header._slots, arrays._spellingSlots);
+            write(writer, written, header._spans, spans.data());
+            write(writer, written, header._text, text.data());
+            write(writer, written, header._statements, arrays._statements);
+            write(writer, written, header._bodyStatements, arrays._bodyStatements);
+            writer.close();
+            if(!writer.isGood()){
+                std::remove(temporary.c_str());
+                return false;
+            }
+        }
+        if(std::rename(temporary.c_str(), path.c_str()) != 0){
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Maps the image at `path` into `trees`. Returns false, and leaves `trees` as it was, if there's no image
+     * or it wasn't made from this source by this version.
+    **/
+    static bool load(const std::string& path, CompactTree& trees, uint64_t sourceHash, uint64_t sourceSize){
+        std::unique_ptr<SourceBuffer> image(new SourceBuffer(path));
+        if(!image->isGood() || image->size() < sizeof(Header)){
+            return false;
+        }
+        const char* base = image->begin();
+        uint64_t imageSize = image->size();
+
+        Header header;
+        std::memcpy(&header, base, sizeof(Header));
+        if(std::memcmp(header._magic, Magic, sizeof(Magic)) != 0 || header._version != Version || header._byteOrder != ByteOrder
+                || header._sourceSize != sourceSize || header._sourceHash != sourceHash){
+            return false;
+        }
+
+        // Every section has to be where it says and as big as the counts say
+        uint64_t nodes = header._nodeCount;
+        uint64_t spellings = header._spellingCount;
+        uint64_t statements = header._statementCount;
+        uint64_t bodyStatements = header._bodyStatementCount;
+        if(nodes == 0 || nodes > UINT32_MAX || spellings > UINT32_MAX
+                || !fits(header._tokens, nodes * sizeof(uint8_t), imageSize)
+                || !fits(header._types, nodes * sizeof(CompactTree::ValueType), imageSize)
+                || !fits(header._left, nodes * sizeof(CompactTree::NodeIndex), imageSize)
+                || !fits(header._right, nodes * sizeof(CompactTree::NodeIndex), imageSize)
+                || !fits(header._spellings, nodes * sizeof(uint32_t), imageSize)
+                || !fits(header._columns, nodes * sizeof(uint32_t), imageSize)
+                || !fits(header._numbers, spellings * sizeof(NumericValue), imageSize)
+                || !fits(header._slots, spellings * sizeof(uint32_t), imageSize)
+                || !fits(header._spans, spellings * sizeof(Span), imageSize)
+                || !fits(header._text, header._text._size, imageSize)
+                || !fits(header._statements, statements * sizeof(CompactTree::Statement), imageSize)
+                || !fits(header._bodyStatements, bodyStatements * sizeof(CompactTree::Statement), imageSize)){
+            return false;
+        }
+        std::array<Section, SectionCount> placed = sectionsOf(header);
+        const void* sections[SectionCount];
+        for(std::size_t i = 0; i < SectionCount; ++i){
+            sections[i] = base + placed[i]._offset;
+        }
+        if(checksumOf(header, sections) != header._checksum){
+            return false;
+        }
+
+        CompactTree::Arrays arrays;
+        arrays._tokens          = (const uint8_t*)(base + header._tokens._offset);
+        arrays._types           = (const CompactTree::ValueType*)(base + header._types._offset);
+        arrays._left            = (const CompactTree::NodeIndex*)(base + header._left._offset);
+        arrays._right           = (const CompactTree::NodeIndex*)(base + header._right._offset);
+        arrays._spellings       = (const uint32_t*)(base + header._spellings._offset);
+        arrays._columns         = (const uint32_t*)(base + header._columns._offset);
+        arrays._nodeCount       = (std::size_t)nodes;
+        arrays._spellingNumbers = (const NumericValue*)(base + header._numbers._offset);
+        arrays._spellingSlots   = (const uint32_t*)(base + header._slots._offset);
+        arrays._spellingCount   = (std::size_t)spellings;
+        arrays._statements      = (const CompactTree::Statement*)(base + header._statements._offset);
+        arrays._statementCount  = (std::size_t)statements;
+        arrays._bodyStatements  = (const CompactTree::Statement*)(base + header._bodyStatements._offset);
+        arrays._bodyStatementCount = (std::size_t)bodyStatements;
+        arrays._slotCount       = header._slotCount;
+
+        const Span* spans = (const Span*)(base + header._spans._offset);
+        const char* text = base + header._text._offset;
+        std::vector<std::string_view> spellingTable(spellings);
+        for(std::size_t i = 0; i < spellings; ++i){
+            if((uint64_t)spans[i]._offset + spans[i]._length > header._text._size){
+                return false;
+            }
+            spellingTable[i] = std::string_view(text + spans[i]._offset, spans[i]._length);
+        }
+        if(!isWellFormed(arrays)){
+            return false;
+        }
+
+        trees.attach(arrays, std::move(spellingTable), std::move(image));
+        return true;
+    }
+
+private:
+    static uint64_t mix(uint64_t value){
+        value *= 0xFF51AFD7ED558CCDull;
+        return value ^ (value >> 32);
+    }
+
+    static std::array<Section, SectionCount> sectionsOf(const Header& header){
+        return {header._tokens, header._types, header._left, header._right, header._spellings, header._columns,
+                header._numbers, header._slots, header._spans, header._text, header._statements, header._bodyStatements};
+    }
+
+    // Of the header, without its checksum, and of the sections at `data`, as big as the header says. The padding isn't read
+    static uint64_t checksumOf(const Header& header, const void* const (&data)[SectionCount]){
+        Header unsummed = header;
+        unsummed._checksum = 0;
+        uint64_t hash = checksum(0x9E3779B97F4A7C15ull, (const char*)&unsummed, sizeof(Header));
+        std::array<Section, SectionCount> sections = sectionsOf(header);
+        for(std::size_t i = 0; i < SectionCount; ++i){
+            hash = checksum(hash, (const char*)data[i], sections[i]._size);
+        }
+        return hash;
+    }
+
+    // Four words at a time on their own lanes, so the multiplications don't wait on each other. Every step can be undone,
+    // so a single damaged word always changes the result. As fast as the image can be read, 60 milliseconds for 230 MB
+    static uint64_t checksum(uint64_t hash, const char* bytes, uint64_t size){
+        hash = mix(hash ^ size);
+        uint64_t lanes[4] = {hash, hash + 1, hash + 2, hash + 3};
+        for(; size >= 32; bytes += 32, size -= 32){
+            for(std::size_t i = 0; i < 4; ++i){
+                uint64_t word;
+                std::memcpy(&word, bytes + 8 * i, 8);
+                lanes[i] = mix(lanes[i] ^ word);
+            }
+        }
+        hash = mix(mix(mix(mix(lanes[0]) ^ lanes[1]) ^ lanes[2]) ^ lanes[3]);
+        for(; size >= 8; bytes += 8, size -= 8){
+            uint64_t word;
+            std::memcpy(&word, bytes, 8);
+            hash = mix(hash ^ word);
+        }
+        if(size > 0){
+            uint64_t tail = 0;
+            std::memcpy(&tail, bytes, (std::size_t)size);
+            hash = mix(hash ^ tail);
+        }
+        return hash;
+    }
+
+    static Section place(uint64_t& offset, uint64_t size){
+        Section section{offset, size};
+        offset = (offset + size + Alignment - 1) & ~(Alignment - 1);
+        return section;
+    }
+
+    static bool fits(const Section& section, uint64_t size, uint64_t imageSize){
+        return section._size == size && section._offset % Alignment == 0
+            && section._offset <= imageSize && size <= imageSize - section._offset;
+    }
+
+    static void padTo(BufferedWriter& writer, uint64_t& written, uint64_t offset){
+        static const char zeros[Alignment] = {};
+        if(offset > written){
+            writer.write(zeros, (std::size_t)(offset - written));
+        }
+        written = offset;
+    }
+
+    static void write(BufferedWriter& writer, uint64_t& written, const Section& section, const void* data){
+        padTo(writer, written, section._offset);
+        if(section._size > 0){
+            writer.write((const char*)data, (std::size_t)section._size);
+        }
+        written += section._size;
+    }
+
+    // What the interpreter relies on. Children come before their parent, so no walk of a loaded tree can loop or leave the arrays
+    static bool isWellFormed(const CompactTree::Arrays& arrays){
+        using LanguageToken = LanguageDictionary::LanguageToken;
+        if(arrays._spellingCount == 0 || arrays._tokens[0] != LanguageToken::InvalidToken || arrays._left[0] != 0 || arrays._right[0] != 0){
+            return false;
+        }
+        for(std::size_t i = 0; i < arrays._spellingCount; ++i){
+            if(arrays._spellingSlots[i] != CompactTree::NoSlot && arrays._spellingSlots[i] >= arrays._slotCount){
+                return false;
+            }
+        }
+        bool isGood = arrays._spellings[0] < arrays._spellingCount;
+        for(std::size_t node = 1; node < arrays._nodeCount; ++node){
+            uint32_t spelling = arrays._spellings[node];
+            isGood &= arrays._tokens[node] < LanguageDictionary::TokenCount;
+            isGood &= arrays._types[node] <= CompactTree::ValueType::Invalid;
+            isGood &= arrays._left[node] < node && arrays._right[node] < node;
+            isGood &= spelling < arrays._spellingCount;
+            if(!isGood){
+                return false;
+            }
+            if(arrays._tokens[node] == LanguageToken::IdentifierToken && arrays._spellingSlots[spelling] == CompactTree::NoSlot){
+                return false;
+            }
+
+            // The interpreter and the compiler take the slot of these children without looking at their token
+            CompactTree::NodeIndex left = arrays._left[node];
+            CompactTree::NodeIndex right = arrays._right[node];
+            switch(arrays._tokens[node]){
+                case LanguageToken::TypeIntegerToken:
+                case LanguageToken::TypeDoubleToken:
+                case LanguageToken::TypeStringToken:
+                    isGood = arrays._tokens[left] == LanguageToken::ColonToken && arrays._tokens[arrays._left[left]] == LanguageToken::IdentifierToken;
+                    break;
+                case LanguageToken::AssignmentToken:
+                    isGood = arrays._tokens[left] == LanguageToken::IdentifierToken;
+                    break;
+                case LanguageToken::RightShiftToken:
+                    isGood = arrays._tokens[right] == LanguageToken::IdentifierToken;
+                    break;
+
+                // The body is a chain of '{'
+                case LanguageToken::WhileToken:
+                case LanguageToken::OpenBraceToken:
+                    isGood = right == CompactTree::NullNode || arrays._tokens[right] == LanguageToken::OpenBraceToken;
+                    break;
+                default:
+                    break;
+            }
+            if(!isGood){
+                return false;
+            }
+        }
+        for(std::size_t i = 0; i < arrays._statementCount; ++i){
+            if(arrays._statements[i]._root >= arrays._nodeCount){
+                return false;
+            }
+        }
+
+        // Sorted by root, getBodyLine() searches them
+        for(std::size_t i = 0; i < arrays._bodyStatementCount; ++i){
+            if(arrays._bodyStatements[i]._root >= arrays._nodeCount || (i > 0 && arrays._bodyStatements[i]._root <= arrays._bodyStatements[i - 1]._root)){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static long processId(){
+#ifndef _WIN32
+        return (long)::getpid();
+#else
+        return 0;
+#endif
+    }
+};
+
+#endif // PROGRAMIMAGE_H
@@ -0,0 +1,166 @@
+#ifndef SOURCEBUFFER_H
+#define SOURCEBUFFER_H
+
+// Standard Libraries
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * Source Buffer
+ * - Holds the whole script as one contiguous, read-only range of characters.
+ * - Regular files are memory-mapped. Pipes, stdin ("-") and platforms without mmap are read into a buffer instead.
+**/
+class SourceBuffer{
+
+private:
+    std::string         _filename       = "";           // The file the buffer was loaded from. "-" is stdin
+    const char*         _data           = nullptr;      // Start of the source
+    std::size_t         _size           = 0;            // Size of the source in bytes
+    bool                _isMapped       = false;        // If the source was mapped instead of read
+    bool                _isGood         = false;        // If the source was loaded
+    std::vector<char>   _storage;                       // Used when the source can't be mapped
+
+// Constructors
+public:
+    SourceBuffer(std::string filename){
+        this->_filename = filename;
+        this->_isGood = load();
+    }
+
+    ~SourceBuffer(){
+        release();
+    }
+
+    // The mapping is owned by the buffer, so it can't be copied
+    SourceBuffer(SourceBuffer const&) = delete;
+    void operator=(SourceBuffer const&) = delete;
+
+// Methods
+public:
+    const char* begin() const{
+        return _data;
+    }
+
+    const char* end() const{
+        return _data + _size;
+    }
+
+    std::size_t size() const{
+        return _size;
+    }
+
+    bool isGood() const{
+        return _isGood;
+    }
+
+    bool isMapped() const{
+        return _isMapped;
+    }
+
+    const std::string& getFilename() const{
+        return _filename;
+    }
+
+private:
+    bool load(){
+#ifndef _WIN32
+        int fd = _filename == "-" ? STDIN_FILENO : ::open(_filename.c_str(), O_RDONLY);
+        if(fd < 0){
+            return false;
+        }
+
+        struct stat info;
+        bool isRegularFile = ::fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+
+        // Only regular files with content can be mapped. mmap of a 0 byte file fails
+        if(isRegularFile && info.st_size > 0){
+            void* mapped = ::mmap(nullptr, (std::size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapped != MAP_FAILED){
+                ::madvise(mapped, (std::size_t)info.st_size, MADV_SEQUENTIAL);
+                _data = (const char*)mapped;
+                _size = (std::size_t)info.st_size;
+                _isMapped = true;
+                closeDescriptor(fd);
+#ifdef DEBUG
+                std::cout << "[/] Mapped [" << _filename << "] (" << _size << " bytes)" << std::endl;
+#endif
+                return true;
+            }
+        }
+
+        // Fallback for pipes, stdin and failed mappings
+        bool isRead = readDescriptor(fd, isRegularFile ? (std::size_t)info.st_size : 0);
+        closeDescriptor(fd);
+        return isRead;
+#else
+        std::FILE* file = _filename == "-" ? stdin : std::fopen(_filename.c_str(), "rb");
+        if(file == nullptr){
+            return false;
+        }
+        char chunk[1 << 16];
+        std::size_t count = 0;
+        while((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0){
+            _storage.insert(_storage.end(), chunk, chunk + count);
+        }
+        if(file != stdin){
+            std::fclose(file);
+        }
+        _data = _storage.data();
+        _size = _storage.size();
+        return true;
+#endif
+    }
+
+#ifndef _WIN32
+    bool readDescriptor(int fd, std::size_t sizeHint){
+        _storage.reserve(sizeHint > 0 ? sizeHint : (1 << 16));
+        char chunk[1 << 16];
+        while(true){
+            ssize_t count = ::read(fd, chunk, sizeof(chunk));
+            if(count == 0){
+                break;
+            }
+            if(count < 0){
+                return false;
+            }
+            _storage.insert(_storage.end(), chunk, chunk + count);
+        }
+        _data = _storage.data();
+        _size = _storage.size();
+#ifdef DEBUG
+        std::cout << "[/] Read [" << _filename << "] (" << _size << " bytes)" << std::endl;
+#endif
+        return true;
+    }
+
+    void closeDescriptor(int fd){
+        if(fd != STDIN_FILENO){
+            ::close(fd);
+        }
+    }
+#endif
+
+    void release(){
+#ifndef _WIN32
+        if(_isMapped){
+            ::munmap((void*)_data, _size);
+        }
+#endif
+        _data = nullptr;
+        _size = 0;
+        _isMapped = false;
+        _storage.clear();
+    }
+};
+
+#endif // SOURCEBUFFER_H
@@ -0,0 +1,297 @@
+#ifndef SOURCESCANNER_H
+#define SOURCESCANNER_H
+
+// Standard Libraries
+#include <cstddef>
+#include <cstdint>
+
+// Created Classes
+#include "../LanguageDictionary/LanguageDictionary.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+    #define HLINT_SCANNER_SSE2
+    #define HLINT_SCANNER_AVX2
+    #include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+    #define HLINT_SCANNER_SSE2
+    #include <intrin.h>
+    #include <emmintrin.h>
+#endif
+
+/**
+ * Source Scanner
+ * - Finds the end of character runs in the source buffer 16 (SSE2) or 32 (AVX2) bytes at a time.
+ * - The kernels are picked once at runtime based on the CPU. Other platforms use the scalar loops.
+ * - Every function returns a pointer in [begin, end]. `end` means the run reaches the end of the source.
+**/
+class SourceScanner{
+
+private:
+    using Kernel = const char* (*)(const char*, const char*);
+
+    struct Kernels{
+        Kernel _identifierEnd;
+        Kernel _digitEnd;
+        Kernel _quote;
+        Kernel _nonWhiteSpace;
+        Kernel _statementEnd;
+    };
+
+public:
+
+    // First character that is not a-z, A-Z, 0-9 or '_'
+    static const char* identifierEnd(const char* begin, const char* end){
+        return kernels()._identifierEnd(begin, end);
+    }
+
+    // First character that is not 0-9 or '.'
+    static const char* digitEnd(const char* begin, const char* end){
+        return kernels()._digitEnd(begin, end);
+    }
+
+    // The closing '"' of a string literal
+    static const char* findQuote(const char* begin, const char* end){
+        return kernels()._quote(begin, end);
+    }
+
+    // First character that is not ' ', '\t', '\n', '\v', '\f' or '\r'
+    static const char* skipWhiteSpace(const char* begin, const char* end){
+        return kernels()._nonWhiteSpace(begin, end);
+    }
+
+    // First ';' or '"'. Quotes are reported as well so the caller can skip the ';' inside string literals
+    static const char* findStatementEnd(const char* begin, const char* end){
+        return kernels()._statementEnd(begin, end);
+    }
+
+    // Name of the instruction set in use. Used for debugging and benchmarks
+    static const char* getInstructionSet(){
+        const Kernels& current = kernels();
+#ifdef HLINT_SCANNER_AVX2
+        if(current._identifierEnd == &identifierEndAVX2){
+            return "AVX2";
+        }
+#endif
+#ifdef HLINT_SCANNER_SSE2
+        if(current._identifierEnd == &identifierEndSSE2){
+            return "SSE2";
+        }
+#endif
+        return "Scalar";
+    }
+
+private:
+    static const Kernels& kernels(){
+        static const Kernels selected = selectKernels();
+        return selected;
+    }
+
+    static Kernels selectKernels(){
+#ifdef HLINT_SCANNER_AVX2
+        if(__builtin_cpu_supports("avx2")){
+            return {&identifierEndAVX2, &digitEndAVX2, &quoteAVX2, &nonWhiteSpaceAVX2, &statementEndAVX2};
+        }
+#endif
+#ifdef HLINT_SCANNER_SSE2
+        return {&identifierEndSSE2, &digitEndSSE2, &quoteSSE2, &nonWhiteSpaceSSE2, &statementEndSSE2};
+#else
+        return {&identifierEndScalar, &digitEndScalar, &quoteScalar, &nonWhiteSpaceScalar, &statementEndScalar};
+#endif
+    }
+
+// Scalar. Also used for the tails that are shorter than a vector
+private:
+    static const char* identifierEndScalar(const char* begin, const char* end){
+        while(begin < end && LanguageDictionary::isIdentifier(*begin)){ ++begin; }
+        return begin;
+    }
+
+    static const char* digitEndScalar(const char* begin, const char* end){
+        while(begin < end && (LanguageDictionary::isDigit(*begin) || *begin == '.')){ ++begin; }
+        return begin;
+    }
+
+    static const char* quoteScalar(const char* begin, const char* end){
+        while(begin < end && *begin != '"'){ ++begin; }
+        return begin;
+    }
+
+    static const char* nonWhiteSpaceScalar(const char* begin, const char* end){
+        while(begin < end && LanguageDictionary::isWhiteSpace(*begin)){ ++begin; }
+        return begin;
+    }
+
+    static const char* statementEndScalar(const char* begin, const char* end){
+        while(begin < end && *begin != ';' && *begin != '"'){ ++begin; }
+        return begin;
+    }
+
+#ifdef HLINT_SCANNER_SSE2
+// SSE2
+private:
+
+    // Byte-wise lo <= x <= hi. SSE2 only has signed compares, so the range is shifted to start at -128
+    static __m128i inRange(__m128i x, char lo, char hi){
+        __m128i shifted = _mm_add_epi8(x, _mm_set1_epi8((char)(0x80 - (unsigned char)lo)));
+        return _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + (unsigned char)(hi - lo + 1))));
+    }
+
+    static __m128i isIdentifier(__m128i x){
+        __m128i lower = _mm_or_si128(x, _mm_set1_epi8(0x20));
+        __m128i letter = inRange(lower, 'a', 'z');
+        __m128i digit = inRange(x, '0', '9');
+        __m128i underscore = _mm_cmpeq_epi8(x, _mm_set1_epi8('_'));
+        return _mm_or_si128(_mm_or_si128(letter, digit), underscore);
+    }
+
+    static __m128i isDigit(__m128i x){
+        return _mm_or_si128(inRange(x, '0', '9'), _mm_cmpeq_epi8(x, _mm_set1_epi8('.')));
+    }
+
+    static __m128i isWhiteSpace(__m128i x){
+        return _mm_or_si128(inRange(x, '\t', '\r'), _mm_cmpeq_epi8(x, _mm_set1_epi8(' ')));
+    }
+
+    // Advances while `matches` holds for every byte and returns the first byte where it doesn't
+    template<typename Matcher>
+    static const char* whileSSE2(const char* begin, const char* end, Matcher matches, Kernel tail){
+        while(end - begin >= 16){
+            __m128i block = _mm_loadu_si128((const __m128i*)begin);
+            unsigned mask = ~(unsigned)_mm_movemask_epi8(matches(block)) & 0xFFFFu;
+            if(mask != 0){
+                return begin + countTrailingZeros(mask);
+            }
+            begin += 16;
+        }
+        return tail(begin, end);
+    }
+
+    static const char* identifierEndSSE2(const char* begin, const char* end){
+        return whileSSE2(begin, end, [](__m128i x){ return isIdentifier(x); }, &identifierEndScalar);
+    }
+
+    static const char* digitEndSSE2(const char* begin, const char* end){
+        return whileSSE2(begin, end, [](__m128i x){ return isDigit(x); }, &digitEndScalar);
+    }
+
+    static const char* quoteSSE2(const char* begin, const char* end){
+        return whileSSE2(begin, end, [](__m128i x){
+            return _mm_xor_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('"')), _mm_set1_epi8(-1));
+        }, &quoteScalar);
+    }
+
+    static const char* nonWhiteSpaceSSE2(const char* begin, const char* end){
+        return whileSSE2(begin, end, [](__m128i x){ return isWhiteSpace(x); }, &nonWhiteSpaceScalar);
+    }
+
+    static const char* statementEndSSE2(const char* begin, const char* end){
+        return whileSSE2(begin, end, [](__m128i x){
+            __m128i boundary = _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(';')), _mm_cmpeq_epi8(x, _mm_set1_epi8('"')));
+            return _mm_xor_si128(boundary, _mm_set1_epi8(-1));
+        }, &statementEndScalar);
+    }
+
+    static unsigned countTrailingZeros(unsigned mask){
+#ifdef _MSC_VER
+        unsigned long index = 0;
+        _BitScanForward(&index, mask);
+        return (unsigned)index;
+#else
+        return (unsigned)__builtin_ctz(mask);
+#endif
+    }
+#endif // HLINT_SCANNER_SSE2
+
+#ifdef HLINT_SCANNER_AVX2
+// AVX2. Only compiled for this set of functions and only called if the CPU supports it
+private:
+    __attribute__((target("avx2")))
+    static __m256i inRange(__m256i x, char lo, char hi){
+        __m256i shifted = _mm256_add_epi8(x, _mm256_set1_epi8((char)(0x80 - (unsigned char)lo)));
+        return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + (unsigned char)(hi - lo + 1))), shifted);
+    }
+
+    // Same as whileSSE2 but 32 bytes at a time. The SSE2 kernel handles the tail
+    template<typename Matcher>
+    __attribute__((target("avx2")))
+    static const char* whileAVX2(const char* begin, const char* end, Matcher matches, Kernel tail){
+        while(end - begin >= 32){
+            __m256i block = _mm256_loadu_si256((const __m256i*)begin);
+            uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(matches(block));
+            if(mask != 0){
+                return begin + __builtin_ctz(mask);
+            }
+            begin += 32;
+        }
+        return tail(begin, end);
+    }
+
+    // Matchers are structs instead of lambdas so the call operator can carry the target attribute as well
+    struct IdentifierAVX2{
+        __attribute__((target("avx2")))
+        __m256i operator()(__m256i x) const{
+            __m256i lower = _mm256_or_si256(x, _mm256_set1_epi8(0x20));
+            __m256i letter = inRange(lower, 'a', 'z');
+            __m256i digit = inRange(x, '0', '9');
+            __m256i underscore = _mm256_cmpeq_epi8(x, _mm256_set1_epi8('_'));
+            return _mm256_or_si256(_mm256_or_si256(letter, digit), underscore);
+        }
+    };
+
+    struct DigitAVX2{
+        __attribute__((target("avx2")))
+        __m256i operator()(__m256i x) const{
+            return _mm256_or_si256(inRange(x, '0', '9'), _mm256_cmpeq_epi8(x, _mm256_set1_epi8('.')));
+        }
+    };
+
+    struct NotQuoteAVX2{
+        __attribute__((target("avx2")))
+        __m256i operator()(__m256i x) const{
+            return _mm256_xor_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('"')), _mm256_set1_epi8(-1));
+        }
+    };
+
+    struct WhiteSpaceAVX2{
+        __attribute__((target("avx2")))
+        __m256i operator()(__m256i x) const{
+            return _mm256_or_si256(inRange(x, '\t', '\r'), _mm256_cmpeq_epi8(x, _mm256_set1_epi8(' ')));
+        }
+    };
+
+    struct NotStatementEndAVX2{
+        __attribute__((target("avx2")))
+        __m256i operator()(__m256i x) const{
+            __m256i boundary = _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(';')), _mm256_cmpeq_epi8(x, _mm256_set1_epi8('"')));
+            return _mm256_xor_si256(boundary, _mm256_set1_epi8(-1));
+        }
+    };
+
+    __attribute__((target("avx2")))
+    static const char* identifierEndAVX2(const char* begin, const char* end){
+        return whileAVX2(begin, end, IdentifierAVX2(), &identifierEndSSE2);
+    }
+
+    __attribute__((target("avx2")))
+    static const char* digitEndAVX2(const char* begin, const char* end){
+        return whileAVX2(begin, end, DigitAVX2(), &digitEndSSE2);
+    }
+
+    __attribute__((target("avx2")))
+    static const char* quoteAVX2(const char* begin, const char* end){
+        return whileAVX2(begin, end, NotQuoteAVX2(), &quoteSSE2);
+    }
+
+    __attribute__((target("avx2")))
+    static const char* nonWhiteSpaceAVX2(const char* begin, const char* end){
+        return whileAVX2(begin, end, WhiteSpaceAVX2(), &nonWhiteSpaceSSE2);
+    }
+
+    __attribute__((target("avx2")))
+    static const char* statementEndAVX2(const char* begin, const char* end){
+        return whileAVX2(begin, end, NotStatementEndAVX2(), &statementEndSSE2);
+    }
+#endif // HLINT_SCANNER_AVX2
+};
+
+#endif // SOURCESCANNER_H
@@ -0,0 +1,134 @@
+#ifndef STANDARDINPUT_H
+#define STANDARDINPUT_H
+
+// Standard Libraries
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+// Created Classes
+#include "../SourceBuffer/sourceBuffer.h"
+
+/**
+ * Standard Input (Singleton)
+ * - Where the script reads its `input >>` lines from: stdin, or the file given with --input-file.
+ * - stdin is read with read(2) into a large buffer, std::cin isn't used at all. A line is found in the buffer and handed out
+ *   as a view, without being copied. From a terminal read(2) returns line by line, so nothing waits for more than one line.
+ * - An input file goes through a SourceBuffer, which maps it when it can. Its lines are views into the mapping.
+ * - Same lines as std::getline: the '\n' is removed, a last line without one is still a line, and past the end every line is "".
+ * - A view is only good until the next readLine().
+**/
+class StandardInput{
+
+private:
+    static constexpr std::size_t Capacity = 1 << 16;           // 64 KiB. Doubled for a line that doesn't fit
+
+private:
+    StandardInput(){}
+    ~StandardInput(){}
+    StandardInput(const StandardInput&) = delete;
+    StandardInput& operator=(const StandardInput&) = delete;
+public:
+    static StandardInput& getInstance(){
+        static StandardInput instance;
+        return instance;
+    }
+
+private:
+    std::unique_ptr<SourceBuffer>   _file;                      // The input file. nullptr for stdin
+    const char*                     _fileCursor     = nullptr;  // Start of the next line of the input file
+    std::vector<char>               _buffer;                    // What was read from stdin
+    std::size_t                     _begin          = 0;        // Start of the next line in the buffer
+    std::size_t                     _scanned        = 0;        // Where the buffer has no '\n' before
+    std::size_t                     _end            = 0;        // End of what was read
+    bool                            _isAtEnd        = false;    // If stdin has nothing more
+
+// Methods
+public:
+    // Read the lines from the file instead of stdin. Returns false if it can't be opened
+    bool open(const std::string& filename){
+        _file = std::make_unique<SourceBuffer>(filename);
+        if(!_file->isGood()){
+            _file.reset();
+            return false;
+        }
+        _fileCursor = _file->begin();
+        return true;
+    }
+
+    std::string_view readLine(){
+        if(_file != nullptr){
+            return readFileLine();
+        }
+        while(true){
+            const char* line = _buffer.data() + _begin;
+            const char* newline = _end > _scanned ? (const char*)std::memchr(_buffer.data() + _scanned, '\n', _end - _scanned) : nullptr;
+            if(newline != nullptr){
+                _begin = _scanned = (std::size_t)(newline - _buffer.data()) + 1;
+                return std::string_view(line, (std::size_t)(newline - line));
+            }
+            if(_isAtEnd){
+                std::string_view rest(line, _end - _begin);
+                _begin = _scanned = _end;
+                return rest;
+            }
+            fill();
+        }
+    }
+
+private:
+    std::string_view readFileLine(){
+        const char* end = _file->end();
+        if(_fileCursor == nullptr || _fileCursor == end){
+            return std::string_view();
+        }
+        const char* line = _fileCursor;
+        const char* newline = (const char*)std::memchr(line, '\n', (std::size_t)(end - line));
+        if(newline == nullptr){
+            _fileCursor = end;
+            return std::string_view(line, (std::size_t)(end - line));
+        }
+        _fileCursor = newline + 1;
+        return std::string_view(line, (std::size_t)(newline - line));
+    }
+
+    // Reads more of stdin after what is left of the buffer. The line being read is moved to the front first
+    void fill(){
+        if(_begin > 0){
+            std::memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+            _end -= _begin;
+            _scanned = _end;
+            _begin = 0;
+        }else{
+            _scanned = _end;
+        }
+        if(_end == _buffer.size()){
+            _buffer.resize(_buffer.empty() ? Capacity : _buffer.size() * 2);
+        }
+#ifndef _WIN32
+        ssize_t count;
+        do{
+            count = ::read(STDIN_FILENO, _buffer.data() + _end, _buffer.size() - _end);
+        }while(count < 0 && errno == EINTR);
+#else
+        std::size_t count = std::fread(_buffer.data() + _end, 1, _buffer.size() - _end, stdin);
+#endif
+        // An error ends the input like the end of the file does
+        if(count <= 0){
+            _isAtEnd = true;
+            return;
+        }
+        _end += (std::size_t)count;
+    }
+};
+
+#endif // STANDARDINPUT_H
@@ -0,0 +1,123 @@
+#ifndef STANDARDOUTPUT_H
+#define STANDARDOUTPUT_H
+
+// Standard Libraries
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#else
+    #include <io.h>
+#endif
+
+// Created Classes
+#include "../BufferedWriter/bufferedWriter.h"
+#include "../NumberText/numberText.h"
+
+/**
+ * Standard Output (Singleton)
+ * - Where the script prints (the `output <<` statements of both engines). Lines go to a buffer that is written to stdout
+ *   with write(2) only when it's full, so printing a line is a copy, not a system call.
+ * - The buffer is also written:
+ *      - at the end of the run, and when the run stops on an error (see LexicalAnalyzer::analyze), before anything else is printed
+ *      - before an `input` when stdin is a terminal, so the user sees what was printed before typing
+ *      - after every line when it's line buffered. By default only when stdout is a terminal (see Options::OutputBuffering)
+ * - Numbers are written by NumberText. Doubles the way std::cout writes them, unless another format is set.
+**/
+class StandardOutput{
+
+private:
+    static constexpr std::size_t Capacity = 1 << 16;           // 64 KiB. Written when it's full
+
+private:
+    StandardOutput() : _writer(1, "stdout", Capacity){
+        this->_isLineBuffered = isTerminal(1);
+        this->_isInteractive = isTerminal(0);
+    }
+    ~StandardOutput(){
+        flush();
+    }
+    StandardOutput(const StandardOutput&) = delete;
+    StandardOutput& operator=(const StandardOutput&) = delete;
+public:
+    static StandardOutput& getInstance(){
+        static StandardOutput instance;
+        return instance;
+    }
+
+private:
+    BufferedWriter  _writer;                                    // stdout
+    bool            _isLineBuffered     = false;                // Written after every line
+    bool            _isInteractive      = false;                // If stdin is a terminal. Written before every input
+    NumberText::Format _doubleFormat    = NumberText::StreamFormat;     // How doubles are written
+
+// Methods
+public:
+    // Text that already ends with its newline, it can be several lines (see BytecodeCompiler::addOutput)
+    void write(std::string_view text){
+        _writer.write(text);
+        endLine();
+    }
+
+    void writeLine(std::string_view text){
+        _writer.write(text);
+        _writer.write('\n');
+        endLine();
+    }
+
+    // A line with the integer
+    void writeInteger(int64_t value){
+        char text[NumberText::MaxLength];
+        char* end = NumberText::writeInteger(text, value);
+        *end++ = '\n';
+        _writer.write(text, (std::size_t)(end - text));
+        endLine();
+    }
+
+    // A line with the double
+    void writeDouble(double value){
+        char text[NumberText::MaxLength];
+        char* end = NumberText::writeDouble(text, value, _doubleFormat);
+        *end++ = '\n';
+        _writer.write(text, (std::size_t)(end - text));
+        endLine();
+    }
+
+    // Before reading stdin
+    void beforeInput(){
+        if(_isInteractive){
+            _writer.flush();
+        }
+    }
+
+    void flush(){
+        _writer.flush();
+    }
+
+    void setLineBuffered(bool isLineBuffered){
+        _isLineBuffered = isLineBuffered;
+    }
+
+    void setDoubleFormat(NumberText::Format format){
+        _doubleFormat = format;
+    }
+
+    static bool isTerminal(int descriptor){
+#ifndef _WIN32
+        return ::isatty(descriptor) != 0;
+#else
+        return _isatty(descriptor) != 0;
+#endif
+    }
+
+private:
+    void endLine(){
+        if(_isLineBuffered){
+            _writer.flush();
+        }
+    }
+};
+
+#endif // STANDARDOUTPUT_H
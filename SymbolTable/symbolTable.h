@@ -1,35 +1,41 @@
 #ifndef SYMBOLTABLE_H
 #define SYMBOLTABLE_H
 
+#include <cstdint>
 #include <iostream>
-#include <map>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 
-#include "objectType.h"
+#include "value.h"
 
 
 /**
  * Symbol Table (Singleton)
  * - Store the list of variables used in the program.
+ * - Variables are found by slot, not by name. Every identifier is given a slot when it's parsed (see CompactTree::getSlot),
+ *   so a lookup is an index into a vector.
+ * - A variable is a Value kept inline in the table. Declaring, assigning and removing one never allocates, except for
+ *   the text of a string, which lives in a pool and is reused from one string variable to the next.
 **/
 class SymbolTable{
 
+public:
+    using Slot = uint32_t;
+
 // variables
 private:
-    // Store the list of variables
-    std::map<std::string, ObjectType*> variableTable;
+    std::vector<Value>          _values;                    // The variables, by slot. Undeclared if the variable isn't declared
+    std::vector<std::string>    _strings;                   // Text of every string variable, by handle (see Value::_string)
+    std::vector<uint32_t>       _freeStrings;               // Handles of the removed string variables
 
     std::string _filename = "RES_SYM.txt";
     std::ofstream _file;
 
 private:
-    SymbolTable(){
-        // Initialize the symbol table
-        this->variableTable = std::map<std::string, ObjectType*>();
-    }
-
+    SymbolTable(){}
     ~SymbolTable(){}
 
 public:
@@ -44,117 +50,135 @@ public:
         return instance;
     }
 
+    // Makes room for slots [0, slotCount). Never shrinks
+    void resize(std::size_t slotCount){
+        if(slotCount > this->_values.size()){
+            this->_values.resize(slotCount);
+        }
+    }
+
 
 // non-destructive methods
 public:
-    void declare(std::string name, ObjectType* variable){
-        if(!this->isVariable(name)){
-            this->variableTable[name] = variable;
-            return;
+    // Declare the variable with the default value of its type: 0, 0.0 or "". Its name is only in the tree (see CompactTree::getSlotNames)
+    void declare(Slot slot, Value::Tag tag){
+        if(this->isVariable(slot)){
+            // ERROR: Variable already exists
+            throw std::runtime_error("ERROR: Variable already exists\n");
+        }
+        switch(tag){
+            case Value::Tag::Integer:
+                this->_values[slot] = Value::ofInteger(0);
+                break;
+            case Value::Tag::Double:
+                this->_values[slot] = Value::ofDouble(0.0);
+                break;
+            case Value::Tag::String:
+                this->_values[slot] = Value::ofString(this->newString());
+                break;
+            case Value::Tag::Undeclared:
+                return;
         }
-        // ERROR: Variable already exists
-        throw std::runtime_error("ERROR: Variable already exists\n");
     }
 
-    ObjectType* get(std::string name){
-        auto value = this->variableTable.find(name) != this->variableTable.end() ? this->variableTable[name] : nullptr;
-        if(value == nullptr){
+    Value& get(Slot slot){
+        if(!this->isVariable(slot)){
             throw std::runtime_error("Variable is not Declared");
         }
-        return value;
+        return this->_values[slot];
     }
 
-    std::vector<std::string> getVariableNames(){
-        std::vector<std::string> names;
-        for(std::map<std::string, ObjectType*>::iterator it = this->variableTable.begin(); it != this->variableTable.end(); it++){
-            names.push_back(it->first);
-        }
-        return names;
+    // The value of the variable at the slot, whose type is already known (see TypeChecker). Still throws if it isn't declared yet
+    int getInteger(Slot slot){
+        return (int)this->get(slot)._integer;
+    }
+
+    double getDouble(Slot slot){
+        return this->get(slot)._double;
+    }
+
+    const std::string& getString(Slot slot){
+        return this->_strings[this->get(slot)._string];
+    }
+
+    void setInteger(Slot slot, int value){
+        this->get(slot)._integer = value;
     }
 
-    std::vector<ObjectType*> getVariables(){
-        std::vector<ObjectType*> variables;
-        for(std::map<std::string, ObjectType*>::iterator it = this->variableTable.begin(); it != this->variableTable.end(); it++){
-            variables.push_back(it->second);
+    void setDouble(Slot slot, double value){
+        this->get(slot)._double = value;
+    }
+
+    void setString(Slot slot, std::string_view value){
+        this->_strings[this->get(slot)._string].assign(value);
+    }
+
+    // `names` by slot, as CompactTree::getSlotNames() gives them
+    std::vector<std::string> getVariableNames(const std::vector<std::string_view>& names){
+        std::vector<std::string> declared;
+        for(std::size_t slot = 0; slot < this->_values.size(); slot++){
+            if(this->_values[slot].isDeclared()){
+                declared.emplace_back(names[slot]);
+            }
         }
-        return variables;
+        return declared;
     }
 
 
 // Destructive Methods
 public:
-    
-    
-    // Assign the value of the variable
-    void set(std::string name, ObjectType* variable){
-        
-        // Happens when you assign a variable that doesn't eixsts
-        if(!this->isVariable(name)){
-            // ERROR: Variable does not exist
-            throw std::runtime_error("ERROR: Variable does not exist\n");
-        }
-        this->variableTable[name] = variable;
-    }
 
     // Remove the variable from the symbol table
-    void remove(std::string name){
-        if(this->isVariable(name)){
-            this->variableTable.erase(name);
+    void remove(Slot slot){
+        if(this->isVariable(slot)){
+            if(this->_values[slot]._tag == Value::Tag::String){
+                this->_freeStrings.push_back(this->_values[slot]._string);
+            }
+            this->_values[slot] = Value();
             return;
         }
         // ERROR: Variable does not exist
         throw std::runtime_error("ERROR: Variable does not exist\n");
     }
 
-   
-// Parsing Auxillary Methods
-public:
-    ObjectTypeInt* parseToInt(ObjectType* variable){
-        if(variable->getType() == "integer"){
-            return (ObjectTypeInt*)variable;
-        }
-        // ERROR: Cannot convert to int
-        std::cout << "ERROR: Cannot convert to int\n";
-        return nullptr;
-    }
-
-    ObjectTypeDouble* parseToDouble(ObjectType *variable){
-        if(variable->getType() == "double"){
-            return (ObjectTypeDouble*)variable;
-        }
-        // ERROR: Cannot convert to double
-        std::cout << "ERROR: Cannot convert to double\n";
-        return nullptr;
-    }
-
-    ObjectTypeString* parseToString(ObjectType *variable){
-        if(variable->getType() == "string"){
-            return (ObjectTypeString*)variable;
+// Strings
+private:
+    // Handle of an empty string. Reuses the text of a removed string variable first
+    uint32_t newString(){
+        if(this->_freeStrings.empty()){
+            this->_strings.emplace_back();
+            return (uint32_t)(this->_strings.size() - 1);
         }
-        // ERROR: Cannot convert to string
-        std::cout << "ERROR: Cannot convert to string\n";
-        return nullptr;
+        uint32_t handle = this->_freeStrings.back();
+        this->_freeStrings.pop_back();
+        this->_strings[handle].clear();
+        return handle;
     }
 
 // Debug
 public:
-    void printVariableTable(){
+    // `names` by slot, as CompactTree::getSlotNames() gives them
+    void printVariableTable(const std::vector<std::string_view>& names){
         std::cout << "Variable Table" << std::endl;
-        for(std::map<std::string, ObjectType*>::iterator it = this->variableTable.begin(); it != this->variableTable.end(); it++){
-            if (it->second->getType() == "integer"){
-                ObjectTypeInt* variable = (ObjectTypeInt*)it->second;
-                std::cout << it->first << " = " << variable->getValue() << std::endl;
-            }else if(it->second->getType() == "double"){
-                ObjectTypeDouble* variable = (ObjectTypeDouble*)it->second;
-                std::cout << it->first << " = " << variable->getValue() << std::endl;
+        for(std::size_t slot = 0; slot < this->_values.size(); slot++){
+            const Value& variable = this->_values[slot];
+            switch(variable._tag){
+                case Value::Tag::Integer:
+                    std::cout << names[slot] << " = " << (int)variable._integer << std::endl;
+                    break;
+                case Value::Tag::Double:
+                    std::cout << names[slot] << " = " << variable._double << std::endl;
+                    break;
+                default:
+                    break;
             }
         }
     }
 
 // Checkers
 public:
-    bool isVariable(std::string token){
-        return this->variableTable.find(token) != this->variableTable.end();
+    bool isVariable(Slot slot){
+        return slot < this->_values.size() && this->_values[slot].isDeclared();
     }
 };
 #endif // SYMBOLTABLE_H
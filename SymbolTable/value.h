@@ -0,0 +1,60 @@
+#ifndef VALUE_H
+#define VALUE_H
+
+// Standard Libraries
+#include <cstdint>
+
+/**
+ * Value
+ * - A variable as it is stored in the SymbolTable: a tag and the value itself, 16 bytes, kept inline in the table.
+ * - An Integer keeps the int semantics of the language (a double stored into it is converted to int), it's only held in 64 bits.
+ * - A String holds a handle: the index of its text in the string pool of the SymbolTable. The text is only reached through
+ *   the SymbolTable, so a Value never owns memory and is copied like an integer.
+ * - Undeclared is the empty entry of the table.
+**/
+struct Value{
+    enum class Tag : uint8_t{
+        Undeclared,
+        Integer,
+        Double,
+        String
+    };
+
+    union{
+        int64_t     _integer;
+        double      _double;
+        uint32_t    _string;                    // Handle in the string pool of the SymbolTable
+    };
+    Tag             _tag        = Tag::Undeclared;
+
+    Value() : _integer(0){}
+
+    static Value ofInteger(int value){
+        Value result;
+        result._integer = value;
+        result._tag = Tag::Integer;
+        return result;
+    }
+
+    static Value ofDouble(double value){
+        Value result;
+        result._double = value;
+        result._tag = Tag::Double;
+        return result;
+    }
+
+    static Value ofString(uint32_t handle){
+        Value result;
+        result._string = handle;
+        result._tag = Tag::String;
+        return result;
+    }
+
+    bool isDeclared() const{
+        return _tag != Tag::Undeclared;
+    }
+};
+
+static_assert(sizeof(Value) == 16, "A Value is a tag and an 8 bytes payload");
+
+#endif // VALUE_H
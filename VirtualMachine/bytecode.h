@@ -0,0 +1,92 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+// Standard Libraries
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Created Classes
+#include "../Interpreter/number.h"
+
+/**
+ * Bytecode
+ * - The instruction set of the VirtualMachine. Every instruction is an opcode and one operand: a slot, an index in one of the pools
+ *   of the Program or the index of an instruction (jumps and calls).
+ * - Numbers are computed on a stack of Number, strings on a stack of std::string. Operands are pushed left first.
+ * - The list is written once here, the opcodes and the dispatch table of the VirtualMachine are both made from it, so they can't
+ *   get out of order. The four forms of an operation follow each other: on the stack, Constant, Integer and Double.
+ *
+ *   PushInteger        i   Push the integer i. Only for integers that fit in the operand, as an int32_t
+ *   PushNumber         k   Push _numbers[k]
+ *   LoadInteger        s   Push the integer variable s
+ *   LoadDouble         s   Push the double variable s
+ *   LoadDeclared       s   Push 0. Only checks that s is declared (a string or a variable that is never declared)
+ *   Add .. Divide          Pop rhs and lhs, push lhs op rhs. See Number
+ *   AddConstant        k   Same with _numbers[k] as rhs, without pushing it. Also for Subtract, Multiply and Divide
+ *   AddInteger         s   Same with the integer variable s as rhs
+ *   AddDouble          s   Same with the double variable s as rhs
+ *   StoreInteger       s   Pop into the integer variable s. Stops on a value it can't hold (see Number::toInt)
+ *   StoreDouble        s   Pop into the double variable s
+ *   Pop                    Pop a number
+ *   CheckDeclared      s   Only checks that s is declared
+ *   PushText           k   Push _texts[k]
+ *   LoadString         s   Push the string variable s
+ *   StoreString        s   Pop a string into the string variable s
+ *   Jump               t   Go to t (back to the condition of a while)
+ *   JumpUnlessLess     t   Pop rhs and lhs, go to t unless lhs < rhs. Also Greater, Equal and NotEqual
+ *   JumpUnlessLessText t   Same with two strings
+ *   Call               t   Run the routine at t (a nested if, see BytecodeCompiler)
+ *   Return                 Back to the instruction after the Call
+ *   PrintInteger       s   Print the integer variable s. Also PrintDouble and PrintString
+ *   PrintText          k   Print _texts[k] as is. It has the newline, and can be the lines of several outputs in a row
+ *   PrintNumber            Pop a number and print it as a double
+ *   InputInteger       s   Read a line into the integer variable s. Also InputDouble and InputString
+ *   InputUndeclared    s   Read a line, then check that s is declared
+ *   DeclareInteger     s   Declare s as an integer. Also DeclareDouble and DeclareString
+ *   Remove             s   Remove s (a declaration under an if, or in a while at the end of every iteration)
+ *   Fail               k   Stop the script with the error _texts[k]
+ *   Halt                   End of the script
+**/
+#define HLINT_OPCODES(OPCODE) \
+    OPCODE(PushInteger) OPCODE(PushNumber) OPCODE(LoadInteger) OPCODE(LoadDouble) OPCODE(LoadDeclared) \
+    OPCODE(Add) OPCODE(AddConstant) OPCODE(AddInteger) OPCODE(AddDouble) \
+    OPCODE(Subtract) OPCODE(SubtractConstant) OPCODE(SubtractInteger) OPCODE(SubtractDouble) \
+    OPCODE(Multiply) OPCODE(MultiplyConstant) OPCODE(MultiplyInteger) OPCODE(MultiplyDouble) \
+    OPCODE(Divide) OPCODE(DivideConstant) OPCODE(DivideInteger) OPCODE(DivideDouble) \
+    OPCODE(StoreInteger) OPCODE(StoreDouble) OPCODE(Pop) OPCODE(CheckDeclared) \
+    OPCODE(PushText) OPCODE(LoadString) OPCODE(StoreString) \
+    OPCODE(Jump) OPCODE(JumpUnlessLess) OPCODE(JumpUnlessGreater) OPCODE(JumpUnlessEqual) OPCODE(JumpUnlessNotEqual) \
+    OPCODE(JumpUnlessLessText) OPCODE(JumpUnlessGreaterText) OPCODE(JumpUnlessEqualText) OPCODE(JumpUnlessNotEqualText) \
+    OPCODE(Call) OPCODE(Return) \
+    OPCODE(PrintInteger) OPCODE(PrintDouble) OPCODE(PrintString) OPCODE(PrintText) OPCODE(PrintNumber) \
+    OPCODE(InputInteger) OPCODE(InputDouble) OPCODE(InputString) OPCODE(InputUndeclared) \
+    OPCODE(DeclareInteger) OPCODE(DeclareDouble) OPCODE(DeclareString) OPCODE(Remove) \
+    OPCODE(Fail) OPCODE(Halt)
+
+struct Bytecode{
+
+    enum class Opcode : uint8_t{
+#define HLINT_OPCODE_NAME(name) name,
+        HLINT_OPCODES(HLINT_OPCODE_NAME)
+#undef HLINT_OPCODE_NAME
+    };
+
+    struct Instruction{
+        Opcode      _opcode;
+        uint32_t    _operand    = 0;
+    };
+
+    // Compiled statements of the script. Only read by the VirtualMachine
+    struct Program{
+        std::vector<Instruction>    _code;                                  // Starts at 0, ends with Halt. The routines are after it
+        std::vector<Number>         _numbers;                               // Constants of PushNumber
+        std::vector<std::string>    _texts;                                 // Constants of PushText and PrintText, messages of Fail
+        std::size_t                 _slotCount          = 0;                // Variables of the script. Their names are in the tree
+        std::size_t                 _numberStackSize    = 0;                // Most numbers on the stack at once
+        std::size_t                 _textStackSize      = 0;                // Most strings on the stack at once
+    };
+};
+
+#endif // BYTECODE_H
@@ -0,0 +1,518 @@
+#ifndef BYTECODECOMPILER_H
+#define BYTECODECOMPILER_H
+
+// Standard Libraries
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Created Classes
+#include "../LanguageDictionary/LanguageDictionary.h"
+#include "../AbstractSyntaxTree/CompactTree.h"
+#include "bytecode.h"
+
+/**
+ * Bytecode Compiler
+ * - Turns the typed trees of the script (see TypeChecker) into a Bytecode::Program for the VirtualMachine.
+ * - Follows the Interpreter case by case, so both engines give the same output and stop on the same error. Whatever the interpreter
+ *   would throw on becomes a Fail at the same place, the compiler itself never stops.
+ * - An if runs its statement the way Interpreter::interpretAll does: "if (a) if (b) S" runs S, then the inner if. The inner if is
+ *   compiled once as a routine and called from both places, so nested ifs don't grow the program exponentially.
+ * - A while is compiled once: its condition, its body, and a jump back to the condition. An iteration only runs the instructions of
+ *   its body, however many times it runs.
+ * - Expressions can be deeper than the call stack, past MaxRecursionDepth they are walked with a stack.
+**/
+class BytecodeCompiler{
+
+private:
+    using LanguageToken = LanguageDictionary::LanguageToken;
+    using NodeIndex = CompactTree::NodeIndex;
+    using ValueType = CompactTree::ValueType;
+    using Opcode = Bytecode::Opcode;
+
+    static constexpr uint32_t NoJump = UINT32_MAX;
+    static constexpr std::size_t BatchSize = 1 << 14;                                   // Instructions compiled before they are run
+    static constexpr std::size_t MaxRecursionDepth = 256;                               // Deeper expressions are compiled with a stack
+    static constexpr std::size_t MaxMergedText = 1 << 12;                               // Longest text of a PrintText that others are merged into
+
+private:
+    const CompactTree&                          _trees;
+    Bytecode::Program*                          _program        = nullptr;          // The batch being compiled
+    std::size_t                                 _numberDepth    = 0;                // Numbers on the stack at this point of the program
+    std::size_t                                 _textDepth      = 0;                // Strings on the stack at this point of the program
+    std::size_t                                 _jumpTarget     = 0;                // Last instruction a jump goes to
+    std::vector<std::pair<NodeIndex, bool>>     _pendingNodes;                      // Walk of addDeepNumber(). The bool is set once the operands are added
+    std::unordered_map<NodeIndex, uint32_t>     _routineIds;                        // Routine of every nested if, by node
+    std::vector<NodeIndex>                      _routines;                          // Nested ifs, by routine id
+    std::vector<uint32_t>                       _routineStarts;                     // First instruction of every routine, by routine id
+
+// Constructors
+public:
+    BytecodeCompiler(const CompactTree& trees) : _trees(trees){}
+
+    BytecodeCompiler(BytecodeCompiler const&) = delete;
+    void operator=(BytecodeCompiler const&) = delete;
+
+// Methods
+public:
+
+    /**
+     * Compiles the statements from `first` on into `program`, until it has about BatchSize instructions. Returns the statement after
+     * the last one compiled.
+     * - A statement never jumps to another one, so the script is compiled and run a batch at a time. The program stays small enough
+     *   to be in the cache, and its memory is used again by the next batch instead of growing with the script. A while is a single
+     *   statement, its whole body is in the batch it starts in.
+    **/
+    std::size_t compile(std::size_t first, Bytecode::Program& program){
+        program._code.clear();
+        program._numbers.clear();
+        program._texts.clear();
+        program._slotCount = _trees.getSlotCount();
+        _program = &program;
+        _jumpTarget = 0;
+        _routineIds.clear();
+        _routines.clear();
+        _routineStarts.clear();
+
+        std::size_t next = first;
+        while(next < _trees.getStatementCount() && program._code.size() < BatchSize){
+            addStatement(_trees.getRoot(next), false);
+            ++next;
+        }
+        add(Opcode::Halt);
+
+        // Routines can call routines that aren't compiled yet
+        for(std::size_t i = 0; i < _routines.size(); ++i){
+            _routineStarts.push_back((uint32_t)program._code.size());
+            addAll(_trees.getRight(_routines[i]), true);
+            addIf(_routines[i]);
+            add(Opcode::Return);
+        }
+        for(Bytecode::Instruction& instruction : program._code){
+            if(instruction._opcode == Opcode::Call){
+                instruction._operand = _routineStarts[instruction._operand];
+            }
+        }
+        return next;
+    }
+
+private:
+    // Same cases as Interpreter::interpret
+    void addStatement(NodeIndex tree, bool isInIf){
+        if(tree == CompactTree::NullNode){
+            return;
+        }
+        switch(_trees.getToken(tree)){
+            case LanguageToken::CharacterToken:
+            case LanguageToken::IdentifierToken:
+            case LanguageToken::NumberToken:
+            case LanguageToken::StringToken:
+            case LanguageToken::NumberIntegerToken:
+            case LanguageToken::NumberDoubleToken:
+            case LanguageToken::LiteralToken:
+            case LanguageToken::OutputToken:
+            case LanguageToken::InputToken:
+            case LanguageToken::AdditionToken:
+            case LanguageToken::SubtractionToken:
+            case LanguageToken::MultiplicationToken:
+            case LanguageToken::DivisionToken:
+            case LanguageToken::LessThanToken:
+            case LanguageToken::GreaterThanToken:
+            case LanguageToken::EqualityToken:
+            case LanguageToken::NotEqualToken:
+            case LanguageToken::ColonToken:
+                // Nothing runs
+                return;
+            case LanguageToken::AssignmentToken:
+                addAssignment(tree);
+                return;
+            case LanguageToken::LeftShiftToken:
+                addOutput(tree);
+                return;
+            case LanguageToken::RightShiftToken:
+                addInput(tree);
+                return;
+            case LanguageToken::IfToken:
+                addIf(tree);
+                return;
+            case LanguageToken::WhileToken:
+                addWhile(tree);
+                return;
+            case LanguageToken::TypeIntegerToken:
+            case LanguageToken::TypeDoubleToken:
+            case LanguageToken::TypeStringToken:
+                addDeclaration(tree, isInIf);
+                return;
+            default:
+                addFail("Token: " + std::string(_trees.getValue(tree)) + ". Either the token is not implemented or there's a problem with the AST");
+                return;
+        }
+    }
+
+    // The statement of an if, see Interpreter::interpretAll
+    void addAll(NodeIndex tree, bool isInIf){
+        if(_trees.getToken(tree) != LanguageToken::IfToken){
+            addStatement(tree, isInIf);
+            return;
+        }
+        auto [found, isNew] = _routineIds.try_emplace(tree, (uint32_t)_routines.size());
+        if(isNew){
+            _routines.push_back(tree);
+        }
+        add(Opcode::Call, found->second);
+    }
+
+    void addIf(NodeIndex tree){
+        uint32_t jump = addCondition(_trees.getLeft(tree));
+        addAll(_trees.getRight(tree), true);
+        if(jump != NoJump){
+            _program->_code[jump]._operand = (uint32_t)_program->_code.size();
+            _jumpTarget = _program->_code.size();
+        }
+    }
+
+    // Same as Interpreter::handleWhile. What the body declares is removed before the condition is checked again
+    void addWhile(NodeIndex tree){
+        uint32_t head = (uint32_t)_program->_code.size();
+        uint32_t jump = addCondition(_trees.getLeft(tree));
+        for(NodeIndex block = _trees.getRight(tree); block != CompactTree::NullNode; block = _trees.getRight(block)){
+            addStatement(_trees.getLeft(block), false);
+        }
+        for(NodeIndex block = _trees.getRight(tree); block != CompactTree::NullNode; block = _trees.getRight(block)){
+            NodeIndex statement = _trees.getLeft(block);
+            if(isDeclaration(_trees.getToken(statement))){
+                add(Opcode::Remove, _trees.getSlot(_trees.getLeft(_trees.getLeft(statement))));
+            }
+        }
+        add(Opcode::Jump, head);
+        if(jump != NoJump){
+            _program->_code[jump]._operand = (uint32_t)_program->_code.size();
+        }
+        _jumpTarget = _program->_code.size();
+    }
+
+    // Index of the jump taken when the condition doesn't hold. NoJump if the condition always stops the script
+    uint32_t addCondition(NodeIndex tree){
+        NodeIndex lhs = _trees.getLeft(tree);
+        NodeIndex rhs = _trees.getRight(tree);
+        ValueType lhsType = typeOf(lhs);
+        ValueType rhsType = typeOf(rhs);
+        bool isText = lhsType == ValueType::String || rhsType == ValueType::String;
+        if(isText && lhsType != rhsType){
+            addFail("Cannot compare string with non-string");
+            return NoJump;
+        }
+        if(isText){
+            addText(lhs);
+            addText(rhs);
+            _textDepth -= 2;
+        }else{
+            addNumber(lhs);
+            addNumber(rhs);
+            _numberDepth -= 2;
+        }
+
+        Opcode opcode;
+        switch(_trees.getToken(tree)){
+            case LanguageToken::LessThanToken:
+                opcode = isText ? Opcode::JumpUnlessLessText : Opcode::JumpUnlessLess;
+                break;
+            case LanguageToken::GreaterThanToken:
+                opcode = isText ? Opcode::JumpUnlessGreaterText : Opcode::JumpUnlessGreater;
+                break;
+            case LanguageToken::EqualityToken:
+                opcode = isText ? Opcode::JumpUnlessEqualText : Opcode::JumpUnlessEqual;
+                break;
+            case LanguageToken::NotEqualToken:
+                opcode = isText ? Opcode::JumpUnlessNotEqualText : Opcode::JumpUnlessNotEqual;
+                break;
+            default:
+                addFail("Invalid Comparison");
+                return NoJump;
+        }
+        add(opcode);
+        return (uint32_t)_program->_code.size() - 1;
+    }
+
+    void addOutput(NodeIndex tree){
+        NodeIndex rhs = _trees.getRight(tree);
+        switch(_trees.getToken(rhs)){
+            case LanguageToken::LiteralToken:
+                addPrint(std::string(_trees.getValue(rhs)));
+                return;
+            case LanguageToken::StringToken:
+                addPrint(withoutQuotes(rhs));
+                return;
+            case LanguageToken::IdentifierToken:
+                switch(typeOf(rhs)){
+                    case ValueType::Integer:    add(Opcode::PrintInteger, _trees.getSlot(rhs));    return;
+                    case ValueType::Double:     add(Opcode::PrintDouble, _trees.getSlot(rhs));     return;
+                    case ValueType::String:     add(Opcode::PrintString, _trees.getSlot(rhs));     return;
+                    default:                    add(Opcode::CheckDeclared, _trees.getSlot(rhs));   return;
+                }
+            default:
+                addNumber(rhs);
+                add(Opcode::PrintNumber);
+                --_numberDepth;
+                return;
+        }
+    }
+
+    // Texts printed one after the other are printed at once, unless a jump goes between them
+    void addPrint(std::string text){
+        text += '\n';
+        if(!_program->_code.empty() && _program->_code.size() != _jumpTarget && _program->_code.back()._opcode == Opcode::PrintText){
+            std::string& previous = _program->_texts[_program->_code.back()._operand];
+            if(previous.size() < MaxMergedText){
+                previous += text;
+                return;
+            }
+        }
+        add(Opcode::PrintText, addConstant(std::move(text)));
+    }
+
+    void addInput(NodeIndex tree){
+        NodeIndex rhs = _trees.getRight(tree);
+        switch(typeOf(rhs)){
+            case ValueType::Integer:    add(Opcode::InputInteger, _trees.getSlot(rhs));     return;
+            case ValueType::Double:     add(Opcode::InputDouble, _trees.getSlot(rhs));      return;
+            case ValueType::String:     add(Opcode::InputString, _trees.getSlot(rhs));      return;
+            default:                    add(Opcode::InputUndeclared, _trees.getSlot(rhs));  return;
+        }
+    }
+
+    void addDeclaration(NodeIndex tree, bool isInIf){
+        NodeIndex identifier = _trees.getLeft(_trees.getLeft(tree));
+        uint32_t slot = _trees.getSlot(identifier);
+        switch(_trees.getToken(tree)){
+            case LanguageToken::TypeIntegerToken:   add(Opcode::DeclareInteger, slot);  break;
+            case LanguageToken::TypeDoubleToken:    add(Opcode::DeclareDouble, slot);   break;
+            default:                                add(Opcode::DeclareString, slot);   break;
+        }
+
+        // Only lives until the end of the if
+        if(isInIf){
+            add(Opcode::Remove, slot);
+        }
+    }
+
+    void addAssignment(NodeIndex tree){
+        NodeIndex lhs = _trees.getLeft(tree);
+        NodeIndex rhs = _trees.getRight(tree);
+        uint32_t slot = _trees.getSlot(lhs);
+        switch(typeOf(lhs)){
+            case ValueType::Integer:
+                addNumber(rhs);
+                add(Opcode::StoreInteger, slot);
+                --_numberDepth;
+                return;
+            case ValueType::Double:
+                addNumber(rhs);
+                add(Opcode::StoreDouble, slot);
+                --_numberDepth;
+                return;
+            case ValueType::String:
+                addText(rhs);
+                add(Opcode::StoreString, slot);
+                --_textDepth;
+                return;
+            default:
+                addNumber(rhs);
+                add(Opcode::Pop);
+                --_numberDepth;
+                add(Opcode::CheckDeclared, slot);
+                return;
+        }
+    }
+
+    // Pushes the value of a number expression. Same order as Interpreter::evaluate, left operand first
+    void addNumber(NodeIndex tree, std::size_t depth = 0){
+        LanguageToken token = _trees.getToken(tree);
+        if(!isArithmetic(token)){
+            addOperand(tree);
+            return;
+        }
+        if(depth == MaxRecursionDepth){
+            addDeepNumber(tree);
+            return;
+        }
+        addNumber(_trees.getLeft(tree), depth + 1);
+        addNumber(_trees.getRight(tree), depth + 1);
+        addOperation(token);
+    }
+
+    // Same as addNumber(), walked with a stack. Expressions can be deeper than the call stack
+    void addDeepNumber(NodeIndex tree){
+        _pendingNodes.clear();
+        _pendingNodes.push_back({tree, false});
+        while(!_pendingNodes.empty()){
+            auto [node, isExpanded] = _pendingNodes.back();
+            _pendingNodes.pop_back();
+            LanguageToken token = _trees.getToken(node);
+            if(!isArithmetic(token)){
+                addOperand(node);
+                continue;
+            }
+            if(!isExpanded){
+                _pendingNodes.push_back({node, true});
+                _pendingNodes.push_back({_trees.getRight(node), false});
+                _pendingNodes.push_back({_trees.getLeft(node), false});
+                continue;
+            }
+            addOperation(token);
+        }
+    }
+
+    // Same cases as Interpreter::operandOf
+    void addOperand(NodeIndex tree){
+        switch(_trees.getToken(tree)){
+            case LanguageToken::InvalidToken:
+                if(tree == CompactTree::NullNode){
+                    push(Opcode::PushInteger, 0);
+                    return;
+                }
+                break;
+            case LanguageToken::NumberIntegerToken:
+                {
+                    int64_t value = _trees.getNumber(tree)._integer;
+                    if(value >= INT32_MIN && value <= INT32_MAX){
+                        push(Opcode::PushInteger, (uint32_t)(int32_t)value);
+                        return;
+                    }
+                    push(Opcode::PushNumber, addConstant(Number::ofLiteral(value)));
+                }
+                return;
+            case LanguageToken::NumberToken:
+            case LanguageToken::NumberDoubleToken:
+                push(Opcode::PushNumber, addConstant(Number::ofDouble(_trees.getNumber(tree)._double)));
+                return;
+            case LanguageToken::IdentifierToken:
+                switch(typeOf(tree)){
+                    case ValueType::Integer:    push(Opcode::LoadInteger, _trees.getSlot(tree));   return;
+                    case ValueType::Double:     push(Opcode::LoadDouble, _trees.getSlot(tree));    return;
+                    default:                    push(Opcode::LoadDeclared, _trees.getSlot(tree));  return;
+                }
+            case LanguageToken::StringToken:
+                addFail("Cannot use a string literal in a mathematical expression");
+                ++_numberDepth;
+                return;
+            default:
+                break;
+        }
+        addFail("Token: " + std::string(_trees.getValue(tree)) + ". Is not a mathematical expression");
+        ++_numberDepth;
+    }
+
+    /**
+     * The operation on the two numbers on top of the stack.
+     * - A right operand that is a constant or a number variable was just pushed. It's given to the operation instead,
+     *   one instruction less to compile and to run. The left operand is still done first.
+    **/
+    void addOperation(LanguageToken token){
+        Opcode opcode;
+        switch(token){
+            case LanguageToken::AdditionToken:          opcode = Opcode::Add;       break;
+            case LanguageToken::SubtractionToken:       opcode = Opcode::Subtract;  break;
+            case LanguageToken::MultiplicationToken:    opcode = Opcode::Multiply;  break;
+            default:                                    opcode = Opcode::Divide;    break;
+        }
+        --_numberDepth;
+
+        // See Bytecode for the order of the forms of an operation
+        Bytecode::Instruction& rhs = _program->_code.back();
+        switch(rhs._opcode){
+            case Opcode::PushInteger:
+                rhs = {(Opcode)((int)opcode + 1), addConstant(Number::ofInteger((int32_t)rhs._operand))};
+                return;
+            case Opcode::PushNumber:
+                rhs = {(Opcode)((int)opcode + 1), rhs._operand};
+                return;
+            case Opcode::LoadInteger:
+                rhs = {(Opcode)((int)opcode + 2), rhs._operand};
+                return;
+            case Opcode::LoadDouble:
+                rhs = {(Opcode)((int)opcode + 3), rhs._operand};
+                return;
+            default:
+                add(opcode);
+                return;
+        }
+    }
+
+    // Pushes the text of a string expression. Same cases as Interpreter::stringOf
+    void addText(NodeIndex tree){
+        switch(_trees.getToken(tree)){
+            case LanguageToken::StringToken:
+                add(Opcode::PushText, addConstant(withoutQuotes(tree)));
+                break;
+            case LanguageToken::LiteralToken:
+                add(Opcode::PushText, addConstant(std::string(_trees.getValue(tree))));
+                break;
+            case LanguageToken::IdentifierToken:
+                if(typeOf(tree) == ValueType::String){
+                    add(Opcode::LoadString, _trees.getSlot(tree));
+                    break;
+                }
+                add(Opcode::CheckDeclared, _trees.getSlot(tree));
+                add(Opcode::PushText, addConstant(std::string()));
+                break;
+            default:
+                addFail("Token: " + std::string(_trees.getValue(tree)) + ". Is not a string");
+                break;
+        }
+        ++_textDepth;
+        _program->_textStackSize = std::max(_program->_textStackSize, _textDepth);
+    }
+
+    void addFail(const std::string& message){
+        add(Opcode::Fail, addConstant(message));
+    }
+
+// Auxillary Methods
+private:
+    void add(Opcode opcode, uint32_t operand = 0){
+        _program->_code.push_back({opcode, operand});
+    }
+
+    // Adds an instruction that pushes a number
+    void push(Opcode opcode, uint32_t operand){
+        add(opcode, operand);
+        ++_numberDepth;
+        _program->_numberStackSize = std::max(_program->_numberStackSize, _numberDepth);
+    }
+
+    uint32_t addConstant(Number number){
+        _program->_numbers.push_back(number);
+        return (uint32_t)_program->_numbers.size() - 1;
+    }
+
+    uint32_t addConstant(std::string text){
+        _program->_texts.push_back(std::move(text));
+        return (uint32_t)_program->_texts.size() - 1;
+    }
+
+    std::string withoutQuotes(NodeIndex tree) const{
+        std::string_view value = _trees.getValue(tree);
+        return std::string(value.substr(1, value.size() - 2));
+    }
+
+    // A missing operand counts as the integer 0
+    ValueType typeOf(NodeIndex tree) const{
+        return tree == CompactTree::NullNode ? ValueType::Integer : _trees.getType(tree);
+    }
+
+    static bool isArithmetic(LanguageToken token){
+        return token == LanguageToken::AdditionToken || token == LanguageToken::SubtractionToken
+            || token == LanguageToken::MultiplicationToken || token == LanguageToken::DivisionToken;
+    }
+
+    static bool isDeclaration(LanguageToken token){
+        return token == LanguageToken::TypeIntegerToken || token == LanguageToken::TypeDoubleToken || token == LanguageToken::TypeStringToken;
+    }
+};
+
+#endif // BYTECODECOMPILER_H
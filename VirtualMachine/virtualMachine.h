@@ -0,0 +1,310 @@
+#ifndef VIRTUALMACHINE_H
+#define VIRTUALMACHINE_H
+
+// Standard Libraries
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Created Classes
+#include "../SymbolTable/symbolTable.h"
+#include "../StandardOutput/standardOutput.h"
+#include "../StandardInput/standardInput.h"
+#include "../NumberText/numberText.h"
+#include "bytecode.h"
+
+// Threaded dispatch: every instruction jumps straight to the next one through a table of labels (a GNU extension).
+// Other compilers, or a build with HLINT_VM_SWITCH defined, go back to a switch
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(HLINT_VM_SWITCH)
+    #define HLINT_VM_COMPUTED_GOTO
+#endif
+
+/**
+ * Virtual Machine (Singleton)
+ * - Runs a Bytecode::Program (see BytecodeCompiler). Same output and same errors as the Interpreter, which stays as the reference.
+ * - Variables are in the SymbolTable, like for the Interpreter, so they are read and written the same way.
+ * - The stacks are sized by the compiler, nothing is checked or grown while running.
+**/
+class VirtualMachine{
+
+private:
+    using Opcode = Bytecode::Opcode;
+    using Instruction = Bytecode::Instruction;
+
+private:
+    VirtualMachine(){}
+    ~VirtualMachine(){}
+    VirtualMachine(const VirtualMachine&) = delete;
+    VirtualMachine& operator=(const VirtualMachine&) = delete;
+public:
+    static VirtualMachine& getInstance(){
+        static VirtualMachine instance;
+        return instance;
+    }
+private:
+    SymbolTable*                _symbolTable        = &SymbolTable::getInstance();          // The symbol table
+    StandardOutput*             _output             = &StandardOutput::getInstance();       // Where the script prints
+    StandardInput*              _input              = &StandardInput::getInstance();        // Where the script reads from
+    std::vector<Number>         _numbers;                                                   // The number stack
+    std::vector<std::string>    _texts;                                                     // The string stack
+    std::vector<const Instruction*> _returns;                                               // Where every routine running goes back to
+
+public:
+    void run(const Bytecode::Program& program){
+        _symbolTable->resize(program._slotCount);
+        if(_numbers.size() <= program._numberStackSize){
+            _numbers.resize(program._numberStackSize + 1);
+        }
+        if(_texts.size() <= program._textStackSize){
+            _texts.resize(program._textStackSize + 1);
+        }
+        _returns.clear();
+
+        const Instruction* code = program._code.data();
+        const Instruction* instruction = code;
+        Number* top = _numbers.data();                                                      // Last number pushed. _numbers[0] is never used
+        std::string* text = _texts.data();                                                  // Last string pushed. _texts[0] is never used
+
+#ifdef HLINT_VM_COMPUTED_GOTO
+    #define HLINT_VM_LABEL(name) &&Label##name,
+        static const void* const labels[] = { HLINT_OPCODES(HLINT_VM_LABEL) };
+    #undef HLINT_VM_LABEL
+    #define CASE(name)  Label##name:
+    #define NEXT()      goto *labels[(std::size_t)instruction->_opcode]
+        NEXT();
+#else
+    #define CASE(name)  case Opcode::name:
+    #define NEXT()      continue
+        for(;;) switch(instruction->_opcode){
+#endif
+
+        // Numbers
+        CASE(PushInteger)
+            *++top = Number::ofInteger((int32_t)instruction->_operand);
+            ++instruction;
+            NEXT();
+        CASE(PushNumber)
+            *++top = program._numbers[instruction->_operand];
+            ++instruction;
+            NEXT();
+        CASE(LoadInteger)
+            *++top = Number::ofInteger(_symbolTable->getInteger(instruction->_operand));
+            ++instruction;
+            NEXT();
+        CASE(LoadDouble)
+            *++top = Number::ofDouble(_symbolTable->getDouble(instruction->_operand));
+            ++instruction;
+            NEXT();
+        CASE(LoadDeclared)
+            _symbolTable->get(instruction->_operand);
+            *++top = Number::ofInteger(0);
+            ++instruction;
+            NEXT();
+    #define HLINT_VM_OPERATION(name, function) \
+        CASE(name) \
+            top[-1] = Number::function(top[-1], top[0]); \
+            --top; \
+            ++instruction; \
+            NEXT(); \
+        CASE(name##Constant) \
+            *top = Number::function(*top, program._numbers[instruction->_operand]); \
+            ++instruction; \
+            NEXT(); \
+        CASE(name##Integer) \
+            *top = Number::function(*top, Number::ofInteger(_symbolTable->getInteger(instruction->_operand))); \
+            ++instruction; \
+            NEXT(); \
+        CASE(name##Double) \
+            *top = Number::function(*top, Number::ofDouble(_symbolTable->getDouble(instruction->_operand))); \
+            ++instruction; \
+            NEXT();
+
+        HLINT_VM_OPERATION(Add, add)
+        HLINT_VM_OPERATION(Subtract, subtract)
+        HLINT_VM_OPERATION(Multiply, multiply)
+        HLINT_VM_OPERATION(Divide, divide)
+    #undef HLINT_VM_OPERATION
+
+        CASE(StoreInteger)
+            {
+                Value& variable = _symbolTable->get(instruction->_operand);
+                variable._integer = top->toInt();
+            }
+            --top;
+            ++instruction;
+            NEXT();
+        CASE(StoreDouble)
+            _symbolTable->setDouble(instruction->_operand, top->toDouble());
+            --top;
+            ++instruction;
+            NEXT();
+        CASE(Pop)
+            --top;
+            ++instruction;
+            NEXT();
+        CASE(CheckDeclared)
+            _symbolTable->get(instruction->_operand);
+            ++instruction;
+            NEXT();
+
+        // Strings
+        CASE(PushText)
+            *++text = program._texts[instruction->_operand];
+            ++instruction;
+            NEXT();
+        CASE(LoadString)
+            *++text = _symbolTable->getString(instruction->_operand);
+            ++instruction;
+            NEXT();
+        CASE(StoreString)
+            _symbolTable->setString(instruction->_operand, *text);
+            --text;
+            ++instruction;
+            NEXT();
+
+        // Conditions. Two integers are compared as integers, anything else as doubles
+        CASE(Jump)
+            instruction = code + instruction->_operand;
+            NEXT();
+    #define HLINT_VM_JUMP_UNLESS(name, op) \
+        CASE(name) \
+            top -= 2; \
+            if(top[1]._isInteger && top[2]._isInteger ? top[1]._integer op top[2]._integer : top[1].toDouble() op top[2].toDouble()){ \
+                ++instruction; \
+            }else{ \
+                instruction = code + instruction->_operand; \
+            } \
+            NEXT();
+    #define HLINT_VM_JUMP_UNLESS_TEXT(name, op) \
+        CASE(name) \
+            text -= 2; \
+            if(text[1] op text[2]){ \
+                ++instruction; \
+            }else{ \
+                instruction = code + instruction->_operand; \
+            } \
+            NEXT();
+
+        HLINT_VM_JUMP_UNLESS(JumpUnlessLess, <)
+        HLINT_VM_JUMP_UNLESS(JumpUnlessGreater, >)
+        HLINT_VM_JUMP_UNLESS(JumpUnlessEqual, ==)
+        HLINT_VM_JUMP_UNLESS(JumpUnlessNotEqual, !=)
+        HLINT_VM_JUMP_UNLESS_TEXT(JumpUnlessLessText, <)
+        HLINT_VM_JUMP_UNLESS_TEXT(JumpUnlessGreaterText, >)
+        HLINT_VM_JUMP_UNLESS_TEXT(JumpUnlessEqualText, ==)
+        HLINT_VM_JUMP_UNLESS_TEXT(JumpUnlessNotEqualText, !=)
+    #undef HLINT_VM_JUMP_UNLESS
+    #undef HLINT_VM_JUMP_UNLESS_TEXT
+
+        // Routines
+        CASE(Call)
+            _returns.push_back(instruction + 1);
+            instruction = code + instruction->_operand;
+            NEXT();
+        CASE(Return)
+            instruction = _returns.back();
+            _returns.pop_back();
+            NEXT();
+
+        // Output
+        CASE(PrintInteger)
+            _output->writeInteger(_symbolTable->getInteger(instruction->_operand));
+            ++instruction;
+            NEXT();
+        CASE(PrintDouble)
+            _output->writeDouble(_symbolTable->getDouble(instruction->_operand));
+            ++instruction;
+            NEXT();
+        CASE(PrintString)
+            _output->writeLine(_symbolTable->getString(instruction->_operand));
+            ++instruction;
+            NEXT();
+        CASE(PrintText)
+            _output->write(program._texts[instruction->_operand]);
+            ++instruction;
+            NEXT();
+        CASE(PrintNumber)
+            _output->writeDouble(top->toDouble());
+            --top;
+            ++instruction;
+            NEXT();
+
+        // Input. Same conversions as Interpreter::handleInput
+        CASE(InputInteger)
+            {
+                _output->beforeInput();
+                std::string_view value = _input->readLine();
+                Value& variable = _symbolTable->get(instruction->_operand);
+                int integer;
+                switch(NumberText::readInteger(value, integer)){
+                    case NumberText::Parsed:        variable._integer = integer;                                    break;
+                    case NumberText::Invalid:       throw std::runtime_error("Cannot convert input to integer");
+                    case NumberText::OutOfRange:    throw std::out_of_range("stoi");
+                }
+            }
+            ++instruction;
+            NEXT();
+        CASE(InputDouble)
+            {
+                _output->beforeInput();
+                std::string_view value = _input->readLine();
+                Value& variable = _symbolTable->get(instruction->_operand);
+                switch(NumberText::readDouble(value, variable._double)){
+                    case NumberText::Parsed:                                                                        break;
+                    case NumberText::Invalid:       throw std::runtime_error("Cannot convert input to double");
+                    case NumberText::OutOfRange:    throw std::out_of_range("stod");
+                }
+            }
+            ++instruction;
+            NEXT();
+        CASE(InputString)
+            {
+                _output->beforeInput();
+                std::string_view value = _input->readLine();
+                _symbolTable->setString(instruction->_operand, value);
+            }
+            ++instruction;
+            NEXT();
+        CASE(InputUndeclared)
+            _output->beforeInput();
+            _input->readLine();
+            _symbolTable->get(instruction->_operand);
+            ++instruction;
+            NEXT();
+
+        // Declarations
+        CASE(DeclareInteger)
+            _symbolTable->declare(instruction->_operand, Value::Tag::Integer);
+            ++instruction;
+            NEXT();
+        CASE(DeclareDouble)
+            _symbolTable->declare(instruction->_operand, Value::Tag::Double);
+            ++instruction;
+            NEXT();
+        CASE(DeclareString)
+            _symbolTable->declare(instruction->_operand, Value::Tag::String);
+            ++instruction;
+            NEXT();
+        CASE(Remove)
+            _symbolTable->remove(instruction->_operand);
+            ++instruction;
+            NEXT();
+
+        CASE(Fail)
+            throw std::runtime_error(program._texts[instruction->_operand]);
+        CASE(Halt)
+            return;
+
+#ifndef HLINT_VM_COMPUTED_GOTO
+        }
+#endif
+    #undef CASE
+    #undef NEXT
+    }
+};
+
+#endif // VIRTUALMACHINE_H
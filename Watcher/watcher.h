@@ -0,0 +1,663 @@
+#ifndef WATCHER_H
+#define WATCHER_H
+
+// Standard Libraries
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Created Classes
+#include "../AbstractSyntaxTree/AbstractSyntaxTree.h"
+#include "../ErrorHandler/errorHandler.h"
+#include "../LanguageDictionary/LanguageDictionary.h"
+#include "../LexicalAnalyzer/lexer.h"
+#include "../LexicalAnalyzer/token.h"
+#include "../SourceBuffer/sourceBuffer.h"
+#include "../SourceBuffer/sourceScanner.h"
+
+/**
+ * Watcher
+ * - Checks the script again every time it's saved, without running it.
+ * - Every statement keeps its tree and its errors. On a save only the statements between the first and the last changed byte
+ *   are lexed, parsed and validated again. The others are reused, moved by however many bytes and lines the edit added.
+ * - Every statement is parsed on its own, so an unbalanced parenthesis is only reported for the statement it is in.
+ *   A while is a single statement, from the 'while' to the '}' of its body.
+ * - Whether a variable is declared depends on every statement before it. So the first declaration and the reported use of every
+ *   variable are kept, and a save only resolves again the variables of the statements it replaced (see resolve).
+ * - A variable has the type of its first declaration anywhere in the script. So a save that rebuilt a declaration types the whole
+ *   script again. Any other save only types the trees it rebuilt, with the variable types that are kept (see AST::typeStatements).
+**/
+class Watcher{
+
+private:
+    using LanguageToken = LanguageDictionary::LanguageToken;
+
+    static constexpr int PollInterval = 200;                                // Milliseconds between two checks of the file
+    static constexpr std::size_t CompareBlock = 4096;                       // Bytes compared at once when looking for the change
+    static constexpr std::size_t MinimumGarbage = 1 << 16;                  // Replaced nodes that are never worth a rebuild of the compact tree
+    static constexpr uint32_t NoStatement = UINT32_MAX;                     // A variable that is never declared, or never reported
+
+    // Everything that is kept for one statement
+    struct Statement{
+        std::size_t             _begin          = 0;                        // Offset of the first byte. Right after the previous ';'
+        std::size_t             _end            = 0;                        // Offset right after the ';' or the '}', or the end of the source
+        bool                    _isEnded        = false;                    // If the statement ends with a ';', or a while with its '}'
+        bool                    _hasTokens      = false;                    // If there is more than whitespace in it
+        bool                    _hasLastEnd     = false;                    // If its last token is a ';' or a '}'. What a full run checks at the end of the file
+        bool                    _isValid        = false;                    // If the validation found no broken node in its tree
+        bool                    _hasTypeError   = false;                    // If its valid tree has a type error. Set once it's typed
+        int                     _lines          = 0;                        // Number of ';' in it. The lexer counts a line per ';'
+        int                     _column         = 0;                        // Column after the last token
+        CompactTree::NodeIndex  _tree           = CompactTree::NullNode;    // The tree of the statement. Only set for ended statements
+        std::vector<Diagnostic> _parseErrors;                               // Lexer and parser errors. Lines are relative to the statement
+        std::vector<Diagnostic> _treeErrors;                                // Validation errors. Lines are relative to the statement
+    };
+
+    // Where a variable stands right before a statement
+    enum class VariableState : uint8_t{
+        Undeclared,
+        Reported,                                                           // Used before it was declared
+        Declared
+    };
+
+    // A variable of the statements a save replaced or added
+    struct ChangedSlot{
+        uint32_t                _slot;
+        int64_t                 _oldDeclaredAt  = NoStatement;              // Where it was before the save, numbered like after the save.
+        int64_t                 _oldReportedAt  = NoStatement;              // Right before the unchanged tail if it was in a replaced statement
+        int64_t                 _lastAdded      = -1;                       // Last added statement that declares or uses it
+        bool                    _isSettled      = false;                    // If the rest of the script is resolved for it
+    };
+
+private:
+    std::string             _filename;                                      // The script that is watched
+    std::vector<char>       _text;                                          // The source the statements were built from
+    std::vector<Statement>  _statements;                                    // Every statement, in source order
+    std::size_t             _garbageNodes   = 0;                            // Nodes of replaced trees that are still in the compact tree
+    std::vector<uint32_t>   _declaredAt;                                    // First statement that declares the variable, by slot
+    std::vector<uint32_t>   _reportedAt;                                    // Statement where the variable is used before it is declared, by slot
+    std::vector<uint32_t>   _lastMentions;                                  // No statement after it declares or uses the variable, by slot
+    std::vector<uint32_t>   _declarationCounts;                             // Statements that declare the variable, by slot
+    std::vector<ChangedSlot> _changedSlots;                                 // Variables of the statements the last save replaced or added
+    std::vector<uint32_t>   _slotMarks;                                     // 1 + index in _changedSlots, by slot. 0 for the others and between two saves
+    AST*                    _ast            = &AST::getInstance();          // Parses and validates the statements
+    ErrorHandler*           _errorHandler   = &ErrorHandler::getInstance(); // Where the errors are shown
+
+// Constructors
+public:
+    Watcher(std::string filename){
+        this->_filename = filename;
+    }
+
+    ~Watcher(){}
+
+    Watcher(Watcher const&) = delete;
+    void operator=(Watcher const&) = delete;
+
+// Methods
+public:
+
+    // Never returns. Stop it with Ctrl+C
+    void run(){
+        if(_filename == "-"){
+            std::cout << "[!] stdin can't be watched. Please provide a file" << std::endl;
+            return;
+        }
+
+        std::filesystem::file_time_type lastWrite;
+        std::uintmax_t lastSize = 0;
+        bool isFirst = true;
+        std::cout << "[/] Watching [" << _filename << "]. Press Ctrl+C to stop" << std::endl;
+
+        while(true){
+            std::error_code error;
+            std::filesystem::file_time_type write = std::filesystem::last_write_time(_filename, error);
+            std::uintmax_t size = error ? 0 : std::filesystem::file_size(_filename, error);
+
+            if(!error && (isFirst || write != lastWrite || size != lastSize)){
+                lastWrite = write;
+                lastSize = size;
+                isFirst = false;
+                check();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(PollInterval));
+        }
+    }
+
+    // Reads the script again, rebuilds what changed and shows the errors
+    void check(){
+        SourceBuffer source(_filename);
+        if(!source.isGood()){
+            std::cout << "[!] Failed to open the file [" << _filename << "]. Maybe it's not existing" << std::endl;
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::size_t rebuilt = update(std::vector<char>(source.begin(), source.end()));
+        report();
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "[/] Rebuilt " << rebuilt << " of " << _statements.size() << " statement(s) in " << elapsed << " ms" << std::endl;
+    }
+
+    /**
+     * Replaces the source with `text` and rebuilds the statements that changed. Returns how many were rebuilt.
+     * - Everything before the first changed byte and after the last changed byte is the same as before.
+     * - Statements that end before the first changed byte are kept as they are.
+     * - From there the new source is split again until a statement ends on a boundary that already existed in the unchanged tail.
+     *   Every statement after it is kept as well, only moved.
+    **/
+    std::size_t update(std::vector<char> text){
+        std::size_t oldSize = _text.size();
+        std::size_t newSize = text.size();
+
+        // Unchanged head and tail. The tail can't overlap the head. Compared a block at a time since most of the file is the same
+        std::size_t limit = std::min(oldSize, newSize);
+        std::size_t prefix = 0;
+        while(limit - prefix >= CompareBlock && std::memcmp(_text.data() + prefix, text.data() + prefix, CompareBlock) == 0){
+            prefix += CompareBlock;
+        }
+        while(prefix < limit && _text[prefix] == text[prefix]){
+            ++prefix;
+        }
+        std::size_t suffix = 0;
+        while(limit - prefix - suffix >= CompareBlock
+                && std::memcmp(_text.data() + oldSize - suffix - CompareBlock, text.data() + newSize - suffix - CompareBlock, CompareBlock) == 0){
+            suffix += CompareBlock;
+        }
+        while(suffix < limit - prefix && _text[oldSize - 1 - suffix] == text[newSize - 1 - suffix]){
+            ++suffix;
+        }
+
+        // First statement that may have changed. A statement without ';' grows with whatever is appended to it
+        std::size_t first = std::partition_point(_statements.begin(), _statements.end(), [prefix](const Statement& statement){
+            return statement._isEnded && statement._end <= prefix;
+        }) - _statements.begin();
+
+        // Nothing changed
+        if(prefix == limit && oldSize == newSize && !_statements.empty()){
+            return 0;
+        }
+        bool isFirst = _statements.empty();
+
+        // Split the changed part again
+        std::vector<Statement> rebuilt;
+        std::size_t reuseFrom = _statements.size();
+        std::ptrdiff_t delta = (std::ptrdiff_t)newSize - (std::ptrdiff_t)oldSize;
+        const char* base = text.data();
+        const char* end = base + newSize;
+        std::size_t begin = first > 0 ? _statements[first - 1]._end : 0;
+
+        while(begin < newSize){
+            Statement statement;
+            statement._begin = begin;
+            statement._end = (std::size_t)(statementEnd(base + begin, end, statement._isEnded) - base);
+            rebuilt.push_back(std::move(statement));
+            begin = rebuilt.back()._end;
+
+            // Reached the unchanged tail on a boundary that existed before. The rest is the same
+            if(rebuilt.back()._isEnded && begin >= newSize - suffix){
+                std::size_t oldEnd = (std::size_t)((std::ptrdiff_t)begin - delta);
+                auto found = std::lower_bound(_statements.begin(), _statements.end(), oldEnd, [](const Statement& statement, std::size_t offset){
+                    return statement._end < offset;
+                });
+                if(found != _statements.end() && found->_end == oldEnd && found->_isEnded){
+                    reuseFrom = (std::size_t)(found - _statements.begin()) + 1;
+                    break;
+                }
+            }
+        }
+
+        // Keep the new source alive before building, the statements are lexed from it. Their nodes come after the ones there are
+        CompactTree::NodeIndex firstNode = (CompactTree::NodeIndex)_ast->getTrees().getNodeCount() + 1;
+        _text = std::move(text);
+        base = _text.data();
+        for(Statement& statement : rebuilt){
+            build(statement, base);
+        }
+
+        // Swap the rebuilt statements in, in place. Allocating a new list for a million statements costs more than the rebuild itself.
+        // The variables of the replaced and the rebuilt trees are noted first, see resolve()
+        std::size_t slotCount = _ast->getTrees().getSlotCount();
+        _declaredAt.resize(slotCount, NoStatement);
+        _reportedAt.resize(slotCount, NoStatement);
+        _lastMentions.resize(slotCount, 0);
+        _declarationCounts.resize(slotCount, 0);
+        _slotMarks.resize(slotCount, 0);
+        _changedSlots.clear();
+        bool isDeclarationChanged = false;
+        for(std::size_t i = first; i < reuseFrom; ++i){
+            _garbageNodes += _ast->countNodes(_statements[i]._tree);
+            markSlots(_statements[i]._tree, -1);
+            isDeclarationChanged = isDeclarationChanged || _ast->hasDeclaration(_statements[i]._tree);
+        }
+        for(std::size_t i = 0; i < rebuilt.size(); ++i){
+            markSlots(rebuilt[i]._tree, (int64_t)(first + i));
+            isDeclarationChanged = isDeclarationChanged || _ast->hasDeclaration(rebuilt[i]._tree);
+        }
+        std::size_t replaced = reuseFrom - first;
+        std::size_t common = std::min(replaced, rebuilt.size());
+        std::move(rebuilt.begin(), rebuilt.begin() + common, _statements.begin() + first);
+        if(rebuilt.size() > replaced){
+            _statements.insert(_statements.begin() + first + common, std::make_move_iterator(rebuilt.begin() + common), std::make_move_iterator(rebuilt.end()));
+        }else{
+            _statements.erase(_statements.begin() + first + common, _statements.begin() + reuseFrom);
+        }
+
+        // Move the tail to where it is in the new source
+        if(delta != 0){
+            for(std::size_t i = first + rebuilt.size(); i < _statements.size(); ++i){
+                _statements[i]._begin = (std::size_t)((std::ptrdiff_t)_statements[i]._begin + delta);
+                _statements[i]._end = (std::size_t)((std::ptrdiff_t)_statements[i]._end + delta);
+            }
+        }
+
+        // Replaced trees stay in the compact tree. Once they outgrow the live ones, everything is rebuilt into an empty one
+        if(_garbageNodes > MinimumGarbage && _garbageNodes * 2 > _ast->getTrees().getNodeCount()){
+            _ast->release();
+            _garbageNodes = 0;
+            for(Statement& statement : _statements){
+                build(statement, base);
+            }
+            resolveAll();
+            typeAll();
+            return _statements.size();
+        }
+
+        if(isFirst){
+            resolveAll();
+        }else{
+            resolve(first, rebuilt.size(), reuseFrom);
+        }
+        if(isFirst || isDeclarationChanged){
+            typeAll();
+        }else{
+            _ast->typeStatements(firstNode, false);
+            for(std::size_t i = first; i < first + rebuilt.size(); ++i){
+                _statements[i]._hasTypeError = _statements[i]._isValid && _ast->hasTypeError(_statements[i]._tree);
+            }
+        }
+        return rebuilt.size();
+    }
+
+    // Logs the errors of every statement in the same order as a full run would
+    void report(){
+        _errorHandler->clear();
+
+        // Lexer and parser errors come first, while the tokens are read
+        int endedCount = 0;
+        const Statement* last = nullptr;
+        for(const Statement& statement : _statements){
+            for(const Diagnostic& diagnostic : statement._parseErrors){
+                _errorHandler->addError(diagnostic, endedCount);
+            }
+            endedCount += statement._lines;
+            if(statement._hasTokens){
+                last = &statement;
+            }
+        }
+
+        // The last token has to be a ';', or the '}' of a while
+        if(last == nullptr || !last->_hasLastEnd){
+            _errorHandler->addError("No semicolon at the end of the file", endedCount, last != nullptr ? last->_column : 0);
+        }
+
+        // Then the errors of the validation. The statements with the errors of the passes over the whole script are noted on the way
+        std::vector<std::pair<uint32_t, uint32_t>> reported;                // Statement and slot of every variable used before it is declared
+        for(std::size_t slot = 0; slot < _reportedAt.size(); ++slot){
+            if(_reportedAt[slot] != NoStatement){
+                reported.push_back({_reportedAt[slot], (uint32_t)slot});
+            }
+        }
+        std::sort(reported.begin(), reported.end());
+        std::vector<std::pair<std::size_t, int>> resolved;                  // Statements that report a variable, with their line
+        std::vector<std::pair<std::size_t, int>> typed;                     // Statements with a type error, with their line
+        int line = 0;
+        for(std::size_t i = 0, next = 0; i < _statements.size(); ++i){
+            const Statement& statement = _statements[i];
+            for(const Diagnostic& diagnostic : statement._treeErrors){
+                _errorHandler->addError(diagnostic, line);
+            }
+            if(next < reported.size() && reported[next].first == i){
+                resolved.push_back({i, line});
+                while(next < reported.size() && reported[next].first == i){
+                    ++next;
+                }
+            }
+            if(statement._hasTypeError){
+                typed.push_back({i, line});
+            }
+            line += statement._lines;
+        }
+
+        // The variables used before they are declared, at their first use
+        for(const std::pair<std::size_t, int>& statement : resolved){
+            _ast->forEachUse(_statements[statement.first]._tree, [&](CompactTree::NodeIndex identifier){
+                uint32_t slot = _ast->getTrees().getSlot(identifier);
+                if(_reportedAt[slot] == statement.first && _slotMarks[slot] == 0){
+                    _ast->reportUndeclared(identifier, statement.second);
+                    _slotMarks[slot] = 1;
+                }
+            });
+        }
+        for(const std::pair<uint32_t, uint32_t>& variable : reported){
+            _slotMarks[variable.second] = 0;
+        }
+
+        // And the type errors
+        for(const std::pair<std::size_t, int>& statement : typed){
+            _ast->reportTypes(_statements[statement.first]._tree, statement.second);
+        }
+
+        if(!_errorHandler->displayError()){
+            std::cout << "[/] No errors found" << std::endl;
+        }
+    }
+
+private:
+    // Lexes, parses and validates a single statement. Lines are counted from the start of the statement
+    void build(Statement& statement, const char* base){
+        statement._parseErrors.clear();
+        statement._treeErrors.clear();
+        statement._tree = CompactTree::NullNode;
+        statement._isValid = false;
+        statement._hasTokens = false;
+        statement._hasLastEnd = false;
+
+        // Parse. The lexer reports straight to the ErrorHandler, so the lexer and parser errors stay in order
+        _errorHandler->captureErrors(&statement._parseErrors);
+        _ast->resetStatement();
+        Lexer lexer(base, base + statement._begin, base + statement._end, 0);
+        try{
+            Token token;
+            while(lexer.next(token)){
+                statement._hasTokens = true;
+                statement._hasLastEnd = token._kind == LanguageToken::EndOfStatementToken || token._kind == LanguageToken::CloseBraceToken;
+                if(token._kind == LanguageToken::InvalidToken){
+                    continue;
+                }
+                _ast->insert(token);
+            }
+            _ast->endSource(lexer.getLine(), lexer.getColumn());
+            statement._tree = _ast->takeTree();
+        }catch(const std::exception& exception){
+            _errorHandler->addError(exception.what());
+        }
+        statement._column = lexer.getColumn();
+        statement._lines = lexer.getLine();
+
+        // Validate
+        _errorHandler->captureErrors(&statement._treeErrors);
+        try{
+            if(statement._tree != CompactTree::NullNode){
+                statement._isValid = _ast->evaluateStatement(statement._tree);
+            }
+        }catch(const std::exception& exception){
+            _errorHandler->addError(exception.what());
+        }
+        _errorHandler->captureErrors(nullptr);
+    }
+
+    /**
+     * Resolves the variables of the whole script. Every statement is rebuilt
+     * - A variable is declared by the first declaration at the top of the script. Used before, it is reported at its first use.
+     *   See AST::resolveVariables, which does the same over the trees of a full run.
+    **/
+    void resolveAll(){
+        std::size_t slotCount = _ast->getTrees().getSlotCount();
+        _declaredAt.assign(slotCount, NoStatement);
+        _reportedAt.assign(slotCount, NoStatement);
+        _lastMentions.assign(slotCount, 0);
+        _declarationCounts.assign(slotCount, 0);
+        _slotMarks.assign(slotCount, 0);
+        _changedSlots.clear();
+        for(std::size_t i = 0; i < _statements.size(); ++i){
+            CompactTree::NodeIndex tree = _statements[i]._tree;
+            if(tree == CompactTree::NullNode){
+                continue;
+            }
+            uint32_t declared = _ast->declaredSlot(tree);
+            if(declared != CompactTree::NoSlot){
+                if(_declaredAt[declared] == NoStatement){
+                    _declaredAt[declared] = (uint32_t)i;
+                }
+                ++_declarationCounts[declared];
+                _lastMentions[declared] = (uint32_t)i;
+            }
+            _ast->forEachUse(tree, [&](CompactTree::NodeIndex identifier){
+                uint32_t slot = _ast->getTrees().getSlot(identifier);
+                if(_declaredAt[slot] == NoStatement && _reportedAt[slot] == NoStatement){
+                    _reportedAt[slot] = (uint32_t)i;
+                }
+                _lastMentions[slot] = (uint32_t)i;
+            });
+        }
+    }
+
+    /**
+     * Resolves again the variables of the statements a save replaced or added. The `added` statements from `first` on
+     * replaced the ones up to `removedEnd`.
+     * - A variable only depends on the statements it is in. The others are where they were, moved by the statements the save added.
+     * - A variable declared before `first` stays declared. The others are resolved again from `first`: through the added statements,
+     *   then through the unchanged tail until nothing in it can change for them (see settle). Mostly that's right at the tail,
+     *   only a declaration or a first use that is gone has to be looked for in it.
+    **/
+    void resolve(std::size_t first, std::size_t added, std::size_t removedEnd){
+        std::size_t tail = first + added;
+        std::ptrdiff_t shift = (std::ptrdiff_t)tail - (std::ptrdiff_t)removedEnd;
+        auto moved = [&](uint32_t statement) -> int64_t{
+            if(statement == NoStatement || statement < first){
+                return statement;
+            }
+            return statement < removedEnd ? (int64_t)tail - 1 : (int64_t)statement + shift;
+        };
+
+        // The changed variables start again from first
+        std::size_t open = 0;
+        for(ChangedSlot& changed : _changedSlots){
+            uint32_t slot = changed._slot;
+            changed._oldDeclaredAt = moved(_declaredAt[slot]);
+            changed._oldReportedAt = moved(_reportedAt[slot]);
+            _lastMentions[slot] = (uint32_t)std::max<int64_t>({moved(_lastMentions[slot]), changed._lastAdded, 0});
+            changed._isSettled = _declaredAt[slot] < first;
+            if(!changed._isSettled){
+                ++open;
+                _declaredAt[slot] = NoStatement;
+                if(_reportedAt[slot] != NoStatement && _reportedAt[slot] >= first){
+                    _reportedAt[slot] = NoStatement;
+                }
+            }
+        }
+
+        // Every other one in the tail moves with it
+        if(shift != 0){
+            for(std::size_t slot = 0; slot < _slotMarks.size(); ++slot){
+                if(_slotMarks[slot] != 0){
+                    continue;
+                }
+                for(std::vector<uint32_t>* statements : {&_declaredAt, &_reportedAt, &_lastMentions}){
+                    uint32_t& statement = (*statements)[slot];
+                    if(statement != NoStatement && statement >= removedEnd){
+                        statement = (uint32_t)((std::ptrdiff_t)statement + shift);
+                    }
+                }
+            }
+        }
+
+        std::vector<uint32_t> visited;                                     // Changed variables in the statement, to see if they settled
+        for(std::size_t i = first; i < tail; ++i){
+            resolveChanged(i, visited);
+        }
+        std::size_t scanEnd = 0;                                            // No open variable is in a statement after it
+        for(ChangedSlot& changed : _changedSlots){
+            if(!changed._isSettled && settle(changed, tail)){
+                --open;
+            }else if(!changed._isSettled){
+                scanEnd = std::max<std::size_t>(scanEnd, _lastMentions[changed._slot]);
+            }
+        }
+        for(std::size_t i = tail; open > 0 && i <= scanEnd && i < _statements.size(); ++i){
+            visited.clear();
+            resolveChanged(i, visited);
+            for(uint32_t index : visited){
+                ChangedSlot& changed = _changedSlots[index];
+                if(!changed._isSettled && settle(changed, i + 1)){
+                    --open;
+                }
+            }
+        }
+
+        for(const ChangedSlot& changed : _changedSlots){
+            _slotMarks[changed._slot] = 0;
+        }
+    }
+
+    // Resolves the changed variables that haven't settled in a statement, like resolveAll()
+    void resolveChanged(std::size_t statement, std::vector<uint32_t>& visited){
+        CompactTree::NodeIndex tree = _statements[statement]._tree;
+        if(tree == CompactTree::NullNode){
+            return;
+        }
+        auto isOpen = [&](uint32_t slot){
+            return _slotMarks[slot] != 0 && !_changedSlots[_slotMarks[slot] - 1]._isSettled;
+        };
+        uint32_t declared = _ast->declaredSlot(tree);
+        if(declared != CompactTree::NoSlot && isOpen(declared)){
+            if(_declaredAt[declared] == NoStatement){
+                _declaredAt[declared] = (uint32_t)statement;
+            }
+            visited.push_back(_slotMarks[declared] - 1);
+        }
+        _ast->forEachUse(tree, [&](CompactTree::NodeIndex identifier){
+            uint32_t slot = _ast->getTrees().getSlot(identifier);
+            if(!isOpen(slot)){
+                return;
+            }
+            if(_declaredAt[slot] == NoStatement && _reportedAt[slot] == NoStatement){
+                _reportedAt[slot] = (uint32_t)statement;
+            }
+            visited.push_back(_slotMarks[slot] - 1);
+        });
+    }
+
+    /**
+     * If nothing from `statement` on can resolve the variable otherwise than it already is. Then its declaration and its report
+     * in the rest of the script, if it has one left, are where they were before the save.
+    **/
+    bool settle(ChangedSlot& changed, std::size_t statement){
+        uint32_t slot = changed._slot;
+        VariableState state = stateAt(_declaredAt[slot], _reportedAt[slot], statement);
+        VariableState oldState = stateAt(changed._oldDeclaredAt, changed._oldReportedAt, statement);
+        bool isSettled = state == oldState                                  // The rest sees it like before
+            || state == VariableState::Declared                             // Nothing changes it anymore
+            || oldState == VariableState::Undeclared                        // What was before has the next declaration and first use
+            || (int64_t)statement > _lastMentions[slot]                     // The rest doesn't have it
+            || (state == VariableState::Reported && _declarationCounts[slot] == 0);
+        if(!isSettled){
+            return false;
+        }
+        if(_declaredAt[slot] == NoStatement && changed._oldDeclaredAt != NoStatement && changed._oldDeclaredAt >= (int64_t)statement){
+            _declaredAt[slot] = (uint32_t)changed._oldDeclaredAt;
+        }
+        if(state == VariableState::Undeclared && changed._oldReportedAt != NoStatement && changed._oldReportedAt >= (int64_t)statement){
+            _reportedAt[slot] = (uint32_t)changed._oldReportedAt;
+        }
+        changed._isSettled = true;
+        return true;
+    }
+
+    static VariableState stateAt(int64_t declaredAt, int64_t reportedAt, std::size_t statement){
+        if(declaredAt < (int64_t)statement){
+            return VariableState::Declared;
+        }
+        return reportedAt < (int64_t)statement ? VariableState::Reported : VariableState::Undeclared;
+    }
+
+    // Takes the variable types from every statement again, and types every tree with them
+    void typeAll(){
+        std::vector<CompactTree::Statement> trees;
+        for(const Statement& statement : _statements){
+            if(statement._tree != CompactTree::NullNode){
+                trees.push_back({statement._tree, 0});
+            }
+        }
+        _ast->attachStatements(trees, {});
+        _ast->typeStatements(1, true);
+        _ast->detachStatements();
+        for(Statement& statement : _statements){
+            statement._hasTypeError = statement._isValid && _ast->hasTypeError(statement._tree);
+        }
+    }
+
+    /**
+     * Notes the variables a statement declares or uses, see resolve(). `statement` is where an added statement goes,
+     * -1 for a replaced one.
+    **/
+    void markSlots(CompactTree::NodeIndex tree, int64_t statement){
+        if(tree == CompactTree::NullNode){
+            return;
+        }
+        uint32_t declared = _ast->declaredSlot(tree);
+        if(declared != CompactTree::NoSlot){
+            markSlot(declared, statement);
+            _declarationCounts[declared] += statement < 0 ? -1 : 1;
+        }
+        _ast->forEachUse(tree, [&](CompactTree::NodeIndex identifier){
+            markSlot(_ast->getTrees().getSlot(identifier), statement);
+        });
+    }
+
+    void markSlot(uint32_t slot, int64_t statement){
+        if(_slotMarks[slot] == 0){
+            _changedSlots.push_back({slot});
+            _slotMarks[slot] = (uint32_t)_changedSlots.size();
+        }
+        ChangedSlot& changed = _changedSlots[_slotMarks[slot] - 1];
+        changed._lastAdded = std::max(changed._lastAdded, statement);
+    }
+
+    // Right after the next ';' outside of a string literal and of the body of a while, or after the '}' that ends the while, or the end of the source
+    static const char* statementEnd(const char* cursor, const char* end, bool& isEnded){
+        isEnded = false;
+        int depth = 0;                                                      // Bodies of whiles the cursor is in
+        while(cursor < end){
+            const char* boundary = SourceScanner::findStatementEnd(cursor, end);
+
+            // The braces before it. There's no string literal in between. A '}' that closes nothing is left to the parser
+            for(; cursor < boundary; ++cursor){
+                if(*cursor == '{'){
+                    ++depth;
+                }else if(*cursor == '}' && depth > 0 && --depth == 0){
+                    isEnded = true;
+                    return cursor + 1;
+                }
+            }
+            if(boundary == end){
+                return end;
+            }
+            if(*boundary == ';'){
+                if(depth == 0){
+                    isEnded = true;
+                    return boundary + 1;
+                }
+                cursor = boundary + 1;
+                continue;
+            }
+            const char* quote = SourceScanner::findQuote(boundary + 1, end);
+            cursor = quote == end ? end : quote + 1;
+        }
+        return end;
+    }
+};
+
+#endif // WATCHER_H
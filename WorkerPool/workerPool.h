@@ -0,0 +1,138 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+// Standard Libraries
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Worker Pool
+ * - A fixed number of threads that run the blocks of a loop. Blocks are handed out in order, so the threads stay close to each other.
+ * - The result of every block is consumed on the calling thread, in block order, as soon as it's done.
+ *   The merge overlaps the work and a result is freed before the later ones are all done.
+ * - Workers are never more than MaximumLead blocks per thread ahead of the consumer, which bounds the memory of the results.
+ * - An exception thrown by a block is rethrown on the calling thread in place of its result. Later blocks are dropped.
+**/
+class WorkerPool{
+
+private:
+    static constexpr std::size_t MaximumLead = 4;                           // Blocks per thread that may wait for the consumer
+
+private:
+    unsigned        _threads;                                               // Number of workers
+
+// Constructors
+public:
+    // 0 threads means one per core
+    WorkerPool(unsigned threads = 0){
+        this->_threads = threads != 0 ? threads : std::thread::hardware_concurrency();
+        if(this->_threads == 0){
+            this->_threads = 1;
+        }
+    }
+
+    WorkerPool(WorkerPool const&) = delete;
+    void operator=(WorkerPool const&) = delete;
+
+// Methods
+public:
+
+    /**
+     * Calls work(block, Result&) for every block in [0, blockCount) on the workers, then consume(Result&) for every block in order.
+     * - work has to be safe to call from several threads at once. consume is only called from the calling thread.
+    **/
+    template<typename Result, typename Work, typename Consume>
+    void run(std::size_t blockCount, Work work, Consume consume){
+
+        // Not worth a thread
+        if(_threads <= 1 || blockCount <= 1){
+            for(std::size_t block = 0; block < blockCount; ++block){
+                Result result;
+                work(block, result);
+                consume(result);
+            }
+            return;
+        }
+
+        std::vector<Result> results(blockCount);
+        std::vector<std::exception_ptr> failures(blockCount);
+        std::vector<char> isDone(blockCount, 0);
+        std::size_t next = 0;                                               // Next block to hand out
+        std::size_t consumed = 0;                                           // Blocks the consumer is done with
+        bool isStopped = false;                                             // The consumer gave up. Don't start anything new
+        std::size_t lead = MaximumLead * _threads;
+        std::mutex mutex;
+        std::condition_variable changed;
+
+        auto worker = [&](){
+            std::unique_lock<std::mutex> lock(mutex);
+            while(true){
+                changed.wait(lock, [&](){ return isStopped || next >= blockCount || next - consumed < lead; });
+                if(isStopped || next >= blockCount){
+                    return;
+                }
+                std::size_t block = next++;
+                lock.unlock();
+                try{
+                    work(block, results[block]);
+                }catch(...){
+                    failures[block] = std::current_exception();
+                }
+                lock.lock();
+                isDone[block] = 1;
+                changed.notify_all();
+            }
+        };
+
+        unsigned threadCount = blockCount < _threads ? (unsigned)blockCount : _threads;
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount);
+        for(unsigned i = 0; i < threadCount; ++i){
+            workers.emplace_back(worker);
+        }
+
+        // Stops the workers before the results go away, whichever way this returns
+        auto stop = [&](){
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                isStopped = true;
+            }
+            changed.notify_all();
+            for(std::thread& thread : workers){
+                thread.join();
+            }
+        };
+
+        try{
+            for(std::size_t block = 0; block < blockCount; ++block){
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&](){ return isDone[block] != 0; });
+                }
+                if(failures[block] != nullptr){
+                    std::rethrow_exception(failures[block]);
+                }
+                consume(results[block]);
+                results[block] = Result();
+
+                std::lock_guard<std::mutex> lock(mutex);
+                ++consumed;
+                changed.notify_all();
+            }
+        }catch(...){
+            stop();
+            throw;
+        }
+        stop();
+    }
+
+    unsigned getThreads() const{
+        return _threads;
+    }
+};
+
+#endif // WORKERPOOL_H
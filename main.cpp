@@ -3,18 +3,22 @@
 //#define DEBUG
 
 int main(int argc, char** argv){
-    
+
+    Options options;
+    if(!Options::parse(argc, argv, options)){
+        Options::printUsage();
+        return 1;
+    }
+    if(options._showHelp){
+        Options::printUsage();
+        return 0;
+    }
+
     // Ensure that the user has provided the file name
-    if (argc == 1){
+    if (!options._hasFilename){
         std::cout << "Please provide the file name. Going to default 'test.txt'" << std::endl;
-        HLint* hlint = new HLint();
-        hlint->start();
-        delete hlint;
-    }else{
-        std::string filename = argv[1];
-        HLint* hlint = new HLint(filename);
-        hlint->start();
-        delete hlint;
     }
+    HLint* hlint = new HLint(options);
+    hlint->start();
+    delete hlint;
 }
-
@@ -0,0 +1,5 @@
+n=0; while IFS= read -r s; do echo "$s" > e.hl
+ a=$(timeout 5 /tmp/base/base.bin e.hl 2>&1 | grep "^\[ERROR\]" | grep -v "not declared\|Expected\|can't\|already")
+ b=$(timeout 5 $1 e.hl --no-cache 2>&1 | grep "^\[ERROR\]" | grep -v "not declared\|Expected\|can't\|already")
+ if [ "$a" != "$b" ]; then n=$((n+1)); echo "== $s"; echo "$a" | sed 's/^/  base: /'; echo "$b" | sed 's/^/  new:  /'; fi
+done < corpus.txt; echo diffs=$n